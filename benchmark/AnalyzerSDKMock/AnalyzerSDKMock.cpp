@@ -0,0 +1,487 @@
+#include "Analyzer.h"
+#include "AnalyzerChannelData.h"
+#include "AnalyzerHelpers.h"
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+// Analyzer
+
+Analyzer::Analyzer()
+:	mMockChannelData( NULL ),
+	mMockSampleRateHz( 0 )
+{
+}
+
+Analyzer::~Analyzer()
+{
+}
+
+void Analyzer::SetAnalyzerSettings( AnalyzerSettings* /*settings*/ ) {}
+void Analyzer::KillThread() {}
+AnalyzerChannelData* Analyzer::GetAnalyzerChannelData( Channel& /*channel*/ ) { return mMockChannelData; }
+void Analyzer::ReportProgress( U64 /*sample_number*/ ) {}
+void Analyzer::SetAnalyzerResults( AnalyzerResults* /*analyzer_results*/ ) {}
+U32 Analyzer::GetSimulationSampleRate() { return mMockSampleRateHz; }
+U32 Analyzer::GetSampleRate() { return mMockSampleRateHz; }
+U64 Analyzer::GetTriggerSample() { return 0; }
+void Analyzer::CheckIfThreadShouldExit() {}
+
+void Analyzer::MockSetChannelData( AnalyzerChannelData* channel_data, U32 sample_rate_hz )
+{
+	mMockChannelData = channel_data;
+	mMockSampleRateHz = sample_rate_hz;
+}
+
+Analyzer2::Analyzer2()
+{
+}
+
+void Analyzer2::SetupResults()
+{
+}
+
+// AnalyzerChannelData
+
+AnalyzerChannelData::AnalyzerChannelData( const std::vector< U64 >& edges, BitState initial_bit_state, U64 end_sample )
+:	mEdges( edges ),
+	mNextEdge( 0 ),
+	mSampleNumber( 0 ),
+	mInitialBitState( initial_bit_state ),
+	mEndSample( end_sample )
+{
+}
+
+U64 AnalyzerChannelData::GetSampleNumber()
+{
+	return mSampleNumber;
+}
+
+BitState AnalyzerChannelData::GetBitState()
+{
+	if( ( mNextEdge & 1 ) == 0 )
+		return mInitialBitState;
+	return ( mInitialBitState == BIT_LOW ) ? BIT_HIGH : BIT_LOW;
+}
+
+U32 AnalyzerChannelData::Advance( U32 num_samples )
+{
+	return AdvanceToAbsPosition( mSampleNumber + num_samples );
+}
+
+U32 AnalyzerChannelData::AdvanceToAbsPosition( U64 sample_number )
+{
+	if( sample_number > mEndSample )
+		throw MockEndOfData();
+
+	U32 transitions = 0;
+	for( ; ( mNextEdge < mEdges.size() ) && ( mEdges[ mNextEdge ] <= sample_number ); ++mNextEdge )
+		++transitions;
+	mSampleNumber = sample_number;
+	return transitions;
+}
+
+void AnalyzerChannelData::AdvanceToNextEdge()
+{
+	if( mNextEdge >= mEdges.size() )
+		throw MockEndOfData();
+	mSampleNumber = mEdges[ mNextEdge++ ];
+}
+
+U64 AnalyzerChannelData::GetSampleOfNextEdge()
+{
+	if( mNextEdge >= mEdges.size() )
+		throw MockEndOfData();
+	return mEdges[ mNextEdge ];
+}
+
+bool AnalyzerChannelData::WouldAdvancingCauseTransition( U32 num_samples )
+{
+	return WouldAdvancingToAbsPositionCauseTransition( mSampleNumber + num_samples );
+}
+
+bool AnalyzerChannelData::WouldAdvancingToAbsPositionCauseTransition( U64 sample_number )
+{
+	if( mNextEdge < mEdges.size() )
+		return mEdges[ mNextEdge ] <= sample_number;
+	if( sample_number > mEndSample )
+		throw MockEndOfData();
+	return false;
+}
+
+void AnalyzerChannelData::TrackMinimumPulseWidth() {}
+U64 AnalyzerChannelData::GetMinimumPulseWidthSoFar() { return 0; }
+
+bool AnalyzerChannelData::DoMoreTransitionsExistInCurrentData()
+{
+	return mNextEdge < mEdges.size();
+}
+
+// AnalyzerResults
+
+Frame::Frame()
+:	mStartingSampleInclusive( 0 ),
+	mEndingSampleInclusive( 0 ),
+	mData1( 0 ),
+	mData2( 0 ),
+	mType( 0 ),
+	mFlags( 0 )
+{
+}
+
+bool Frame::HasFlag( U8 flag )
+{
+	return ( mFlags & flag ) != 0;
+}
+
+AnalyzerResults::AnalyzerResults()
+:	mMockPacketStart( 0 ),
+	mMockMarkers( 0 ),
+	mMockErrorMarkers( 0 ),
+	mMockCommits( 0 )
+{
+}
+
+AnalyzerResults::~AnalyzerResults()
+{
+}
+
+void AnalyzerResults::AddChannelBubblesWillAppearOn( const Channel& /*channel*/ ) {}
+
+U64 AnalyzerResults::AddFrame( const Frame& frame )
+{
+	mMockFrames.push_back( frame );
+	return mMockFrames.size() - 1;
+}
+
+U64 AnalyzerResults::CommitPacketAndStartNewPacket()
+{
+	MockPacket packet = { mMockPacketStart, mMockFrames.size() - 1, INVALID_RESULT_INDEX };
+	mMockPackets.push_back( packet );
+	mMockPacketStart = mMockFrames.size();
+	return mMockPackets.size() - 1;
+}
+
+void AnalyzerResults::CancelPacketAndStartNewPacket()
+{
+	mMockPacketStart = mMockFrames.size();
+}
+
+void AnalyzerResults::AddPacketToTransaction( U64 transaction_id, U64 packet_id )
+{
+	mMockPackets[ packet_id ].mTransaction = transaction_id;
+	mMockTransactions[ transaction_id ].push_back( packet_id );
+}
+
+void AnalyzerResults::AddMarker( U64 /*sample_number*/, MarkerType marker_type, Channel& /*channel*/ )
+{
+	++mMockMarkers;
+	if( ( marker_type == ErrorDot ) || ( marker_type == ErrorSquare ) || ( marker_type == ErrorX ) )
+		++mMockErrorMarkers;
+}
+
+void AnalyzerResults::CommitResults()
+{
+	++mMockCommits;
+}
+
+U64 AnalyzerResults::GetNumFrames() { return mMockFrames.size(); }
+U64 AnalyzerResults::GetNumPackets() { return mMockPackets.size(); }
+Frame AnalyzerResults::GetFrame( U64 frame_id ) { return mMockFrames[ frame_id ]; }
+
+U64 AnalyzerResults::GetPacketContainingFrame( U64 frame_id )
+{
+	// packets are in frame order
+	size_t low = 0;
+	size_t high = mMockPackets.size();
+	while( low < high )
+	{
+		size_t middle = ( low + high ) / 2;
+		if( mMockPackets[ middle ].mLastFrame < frame_id )
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	if( ( low < mMockPackets.size() ) && ( mMockPackets[ low ].mFirstFrame <= frame_id ) )
+		return low;
+	return INVALID_RESULT_INDEX;
+}
+
+U64 AnalyzerResults::GetPacketContainingFrameSequential( U64 frame_id )
+{
+	return GetPacketContainingFrame( frame_id );
+}
+
+void AnalyzerResults::GetFramesContainedInPacket( U64 packet_id, U64* first_frame_id, U64* last_frame_id )
+{
+	*first_frame_id = mMockPackets[ packet_id ].mFirstFrame;
+	*last_frame_id = mMockPackets[ packet_id ].mLastFrame;
+}
+
+U32 AnalyzerResults::GetTransactionContainingPacket( U64 packet_id )
+{
+	return U32( mMockPackets[ packet_id ].mTransaction );
+}
+
+void AnalyzerResults::GetPacketsContainedInTransaction( U64 transaction_id, U64** packet_id_array, U64* packet_id_count )
+{
+	std::map< U64, std::vector< U64 > >::iterator transaction = mMockTransactions.find( transaction_id );
+	if( transaction == mMockTransactions.end() )
+	{
+		*packet_id_array = NULL;
+		*packet_id_count = 0;
+		return;
+	}
+	*packet_id_array = &transaction->second[ 0 ];
+	*packet_id_count = transaction->second.size();
+}
+
+void AnalyzerResults::ClearResultStrings()
+{
+	mMockString.clear();
+}
+
+void AnalyzerResults::AddResultString( const char* str1, const char* str2, const char* str3, const char* str4, const char* str5, const char* str6 )
+{
+	const char* strings[] = { str1, str2, str3, str4, str5, str6 };
+	mMockString.clear();
+	for( U32 i = 0; ( i < 6 ) && ( strings[ i ] != NULL ); ++i )
+		mMockString += strings[ i ];
+}
+
+bool AnalyzerResults::UpdateExportProgressAndCheckForCancel( U64 /*completed_frames*/, U64 /*total_frames*/ )
+{
+	return false;
+}
+
+void AnalyzerResults::ClearTabularText()
+{
+	mMockString.clear();
+}
+
+void AnalyzerResults::AddTabularText( const char* str1, const char* str2, const char* str3, const char* str4, const char* str5, const char* str6 )
+{
+	AddResultString( str1, str2, str3, str4, str5, str6 );
+}
+
+U64 AnalyzerResults::MockGetMemoryBytes() const
+{
+	// a marker is a sample number and a type
+	U64 bytes = mMockFrames.size() * sizeof( Frame ) + mMockPackets.size() * sizeof( MockPacket ) + mMockMarkers * ( sizeof( U64 ) + sizeof( U64 ) );
+	for( std::map< U64, std::vector< U64 > >::const_iterator i = mMockTransactions.begin(); i != mMockTransactions.end(); ++i )
+		bytes += sizeof( U64 ) + i->second.size() * sizeof( U64 );
+	return bytes;
+}
+
+// AnalyzerSettings
+
+AnalyzerSettings::AnalyzerSettings()
+{
+}
+
+AnalyzerSettings::~AnalyzerSettings()
+{
+}
+
+void AnalyzerSettings::ClearChannels() {}
+void AnalyzerSettings::AddChannel( Channel& /*channel*/, const char* /*channel_label*/, bool /*is_used*/ ) {}
+void AnalyzerSettings::SetErrorText( const char* /*error_text*/ ) {}
+void AnalyzerSettings::AddInterface( AnalyzerSettingInterface* /*analyzer_setting_interface*/ ) {}
+void AnalyzerSettings::AddExportOption( U32 /*user_id*/, const char* /*menu_text*/ ) {}
+void AnalyzerSettings::AddExportExtension( U32 /*user_id*/, const char* /*extension_description*/, const char* /*extension*/ ) {}
+
+const char* AnalyzerSettings::SetReturnString( const char* str )
+{
+	mMockReturnString = str;
+	return mMockReturnString.c_str();
+}
+
+// SimulationChannelDescriptor
+
+SimulationChannelDescriptor::SimulationChannelDescriptor()
+:	mSampleRateHz( 0 ),
+	mInitialBitState( BIT_LOW ),
+	mBitState( BIT_LOW ),
+	mSampleNumber( 0 )
+{
+}
+
+void SimulationChannelDescriptor::Transition()
+{
+	mEdges.push_back( mSampleNumber );
+	mBitState = ( mBitState == BIT_LOW ) ? BIT_HIGH : BIT_LOW;
+}
+
+void SimulationChannelDescriptor::TransitionIfNeeded( BitState bit_state )
+{
+	if( bit_state != mBitState )
+		Transition();
+}
+
+void SimulationChannelDescriptor::Advance( U32 num_samples_to_advance ) { mSampleNumber += num_samples_to_advance; }
+BitState SimulationChannelDescriptor::GetCurrentBitState() { return mBitState; }
+U64 SimulationChannelDescriptor::GetCurrentSampleNumber() { return mSampleNumber; }
+void SimulationChannelDescriptor::SetChannel( Channel& channel ) { mChannel = channel; }
+void SimulationChannelDescriptor::SetSampleRate( U32 sample_rate_hz ) { mSampleRateHz = sample_rate_hz; }
+void SimulationChannelDescriptor::SetInitialBitState( BitState intial_bit_state ) { mInitialBitState = mBitState = intial_bit_state; }
+Channel SimulationChannelDescriptor::GetChannel() { return mChannel; }
+U32 SimulationChannelDescriptor::GetSampleRate() { return mSampleRateHz; }
+BitState SimulationChannelDescriptor::GetInitialBitState() { return mInitialBitState; }
+
+// AnalyzerHelpers
+
+bool AnalyzerHelpers::IsEven( U64 value ) { return ( value & 1 ) == 0; }
+bool AnalyzerHelpers::IsOdd( U64 value ) { return ( value & 1 ) != 0; }
+
+U32 AnalyzerHelpers::GetOnesCount( U64 value )
+{
+	U32 count = 0;
+	for( ; value != 0; value &= value - 1 )
+		++count;
+	return count;
+}
+
+U32 AnalyzerHelpers::Diff32( U32 a, U32 b )
+{
+	return ( a > b ) ? a - b : b - a;
+}
+
+void AnalyzerHelpers::GetNumberString( U64 number, DisplayBase display_base, U32 num_data_bits, char* result_string, U32 result_string_max_length )
+{
+	switch( display_base )
+	{
+	case Binary:
+		{
+			std::string bits( "0b" );
+			for( U32 i = num_data_bits; i > 0; --i )
+				bits += ( ( number >> ( i - 1 ) ) & 0x1 ) ? '1' : '0';
+			snprintf( result_string, result_string_max_length, "%s", bits.c_str() );
+		}
+		break;
+	case Decimal:
+		snprintf( result_string, result_string_max_length, "%llu", number );
+		break;
+	case ASCII:
+		if( ( number >= 32 ) && ( number < 127 ) )
+		{
+			snprintf( result_string, result_string_max_length, "'%c'", char( number ) );
+			break;
+		}
+		// fall through - not printable
+	case Hexadecimal:
+	case AsciiHex:
+	default:
+		snprintf( result_string, result_string_max_length, "0x%0*llX", int( ( num_data_bits + 3 ) / 4 ), number );
+		break;
+	}
+}
+
+void AnalyzerHelpers::GetTimeString( U64 sample, U64 trigger_sample, U32 sample_rate_hz, char* result_string, U32 result_string_max_length )
+{
+	snprintf( result_string, result_string_max_length, "%.9f", ( double( sample ) - double( trigger_sample ) ) / double( sample_rate_hz ) );
+}
+
+void AnalyzerHelpers::Assert( const char* message )
+{
+	fprintf( stderr, "%s\n", message );
+	abort();
+}
+
+U64 AnalyzerHelpers::AdjustSimulationTargetSample( U64 target_sample, U32 sample_rate, U32 simulation_sample_rate )
+{
+	return U64( double( target_sample ) * double( simulation_sample_rate ) / double( sample_rate ) );
+}
+
+bool AnalyzerHelpers::DoesFileExist( const char* file )
+{
+	FILE* handle = fopen( file, "rb" );
+	if( handle == NULL )
+		return false;
+	fclose( handle );
+	return true;
+}
+
+void* AnalyzerHelpers::StartFile( const char* file, bool append )
+{
+	return fopen( file, append ? "ab" : "wb" );
+}
+
+void AnalyzerHelpers::AppendToFile( U8* data, U32 data_length, void* file )
+{
+	fwrite( data, 1, data_length, ( FILE* )file );
+}
+
+void AnalyzerHelpers::EndFile( void* file )
+{
+	fclose( ( FILE* )file );
+}
+
+S64 AnalyzerHelpers::ConvertToSignedNumber( U64 number, U32 num_bits )
+{
+	if( ( num_bits < 64 ) && ( ( ( number >> ( num_bits - 1 ) ) & 0x1 ) != 0 ) )
+		return S64( number | ( ~0ull << num_bits ) );
+	return S64( number );
+}
+
+// SimpleArchive
+
+SimpleArchive::SimpleArchive()
+:	mPosition( 0 )
+{
+}
+
+SimpleArchive::~SimpleArchive()
+{
+}
+
+void SimpleArchive::SetString( const char* archive_string )
+{
+	mData = archive_string;
+	mPosition = 0;
+}
+
+const char* SimpleArchive::GetString()
+{
+	return mData.c_str();
+}
+
+template< typename T > static bool AppendToken( std::string& data, const T& value )
+{
+	std::ostringstream token;
+	token << value << ' ';
+	data += token.str();
+	return true;
+}
+
+bool SimpleArchive::operator<<( U64 data ) { return AppendToken( mData, data ); }
+bool SimpleArchive::operator<<( U32 data ) { return AppendToken( mData, data ); }
+bool SimpleArchive::operator<<( S64 data ) { return AppendToken( mData, data ); }
+bool SimpleArchive::operator<<( S32 data ) { return AppendToken( mData, data ); }
+bool SimpleArchive::operator<<( double data ) { return AppendToken( mData, data ); }
+bool SimpleArchive::operator<<( bool data ) { return AppendToken( mData, data ? 1 : 0 ); }
+bool SimpleArchive::operator<<( const char* data ) { return AppendToken( mData, data ); }
+bool SimpleArchive::operator<<( Channel& data ) { return AppendToken( mData, data.mDeviceId ) && AppendToken( mData, data.mChannelIndex ); }
+
+bool SimpleArchive::NextToken()
+{
+	while( ( mPosition < mData.size() ) && ( mData[ mPosition ] == ' ' ) )
+		++mPosition;
+	if( mPosition >= mData.size() )
+		return false;
+
+	size_t end = mData.find( ' ', mPosition );
+	if( end == std::string::npos )
+		end = mData.size();
+	mToken = mData.substr( mPosition, end - mPosition );
+	mPosition = end;
+	return true;
+}
+
+bool SimpleArchive::operator>>( U64& data ) { if( NextToken() == false ) return false; data = strtoull( mToken.c_str(), NULL, 10 ); return true; }
+bool SimpleArchive::operator>>( U32& data ) { if( NextToken() == false ) return false; data = U32( strtoul( mToken.c_str(), NULL, 10 ) ); return true; }
+bool SimpleArchive::operator>>( S64& data ) { if( NextToken() == false ) return false; data = strtoll( mToken.c_str(), NULL, 10 ); return true; }
+bool SimpleArchive::operator>>( S32& data ) { if( NextToken() == false ) return false; data = S32( strtol( mToken.c_str(), NULL, 10 ) ); return true; }
+bool SimpleArchive::operator>>( double& data ) { if( NextToken() == false ) return false; data = strtod( mToken.c_str(), NULL ); return true; }
+bool SimpleArchive::operator>>( bool& data ) { if( NextToken() == false ) return false; data = mToken != "0"; return true; }
+bool SimpleArchive::operator>>( char const** data ) { if( NextToken() == false ) return false; *data = mToken.c_str(); return true; }
+bool SimpleArchive::operator>>( Channel& data ) { return ( *this >> data.mDeviceId ) && ( *this >> data.mChannelIndex ); }
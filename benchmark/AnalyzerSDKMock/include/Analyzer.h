@@ -0,0 +1,49 @@
+#ifndef ANALYZER
+#define ANALYZER
+
+#include "AnalyzerTypes.h"
+#include "AnalyzerResults.h"
+#include "AnalyzerSettings.h"
+#include "SimulationChannelDescriptor.h"
+
+class AnalyzerChannelData;
+
+class ANALYZER_EXPORT Analyzer
+{
+public:
+	Analyzer();
+	virtual ~Analyzer();
+
+	virtual void WorkerThread() = 0;
+	virtual U32 GenerateSimulationData( U64 newest_sample_requested, U32 sample_rate, SimulationChannelDescriptor** simulation_channels ) = 0;
+	virtual U32 GetMinimumSampleRateHz() = 0;
+	virtual const char* GetAnalyzerName() const = 0;
+	virtual bool NeedsRerun() = 0;
+
+	void SetAnalyzerSettings( AnalyzerSettings* settings );
+	void KillThread();
+	AnalyzerChannelData* GetAnalyzerChannelData( Channel& channel );
+	void ReportProgress( U64 sample_number );
+	void SetAnalyzerResults( AnalyzerResults* analyzer_results );
+	U32 GetSimulationSampleRate();
+	U32 GetSampleRate();
+	U64 GetTriggerSample();
+	void CheckIfThreadShouldExit();
+
+	// the capture WorkerThread() decodes
+	void MockSetChannelData( AnalyzerChannelData* channel_data, U32 sample_rate_hz );
+
+protected:
+	AnalyzerChannelData* mMockChannelData;
+	U32 mMockSampleRateHz;
+};
+
+class ANALYZER_EXPORT Analyzer2 : public Analyzer
+{
+public:
+	Analyzer2();
+
+	virtual void SetupResults();
+};
+
+#endif //ANALYZER
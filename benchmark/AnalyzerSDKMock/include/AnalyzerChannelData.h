@@ -0,0 +1,42 @@
+#ifndef ANALYZERCHANNELDATA
+#define ANALYZERCHANNELDATA
+
+#include "AnalyzerTypes.h"
+#include <vector>
+
+// Replays a captured channel from its edges. Logic would block at the end of the data until more is
+// captured; the mock throws MockEndOfData instead, which ends the analyzer's WorkerThread().
+
+struct MockEndOfData {};
+
+class ANALYZER_EXPORT AnalyzerChannelData
+{
+public:
+	// edges: sample numbers of the transitions, ascending; end_sample: the last captured sample
+	AnalyzerChannelData( const std::vector< U64 >& edges, BitState initial_bit_state, U64 end_sample );
+
+	U64 GetSampleNumber();
+	BitState GetBitState();
+
+	U32 Advance( U32 num_samples );
+	U32 AdvanceToAbsPosition( U64 sample_number );
+	void AdvanceToNextEdge();
+
+	U64 GetSampleOfNextEdge();
+	bool WouldAdvancingCauseTransition( U32 num_samples );
+	bool WouldAdvancingToAbsPositionCauseTransition( U64 sample_number );
+
+	void TrackMinimumPulseWidth();
+	U64 GetMinimumPulseWidthSoFar();
+
+	bool DoMoreTransitionsExistInCurrentData();
+
+protected:
+	const std::vector< U64 >& mEdges;
+	size_t mNextEdge;
+	U64 mSampleNumber;
+	BitState mInitialBitState;
+	U64 mEndSample;
+};
+
+#endif //ANALYZERCHANNELDATA
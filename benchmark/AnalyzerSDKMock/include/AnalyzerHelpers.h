@@ -0,0 +1,65 @@
+#ifndef ANALYZER_HELPERS_H
+#define ANALYZER_HELPERS_H
+
+#include "Analyzer.h"
+#include <string>
+
+class ANALYZER_EXPORT AnalyzerHelpers
+{
+public:
+	static bool IsEven( U64 value );
+	static bool IsOdd( U64 value );
+	static U32 GetOnesCount( U64 value );
+	static U32 Diff32( U32 a, U32 b );
+
+	static void GetNumberString( U64 number, DisplayBase display_base, U32 num_data_bits, char* result_string, U32 result_string_max_length );
+	static void GetTimeString( U64 sample, U64 trigger_sample, U32 sample_rate_hz, char* result_string, U32 result_string_max_length );
+
+	static void Assert( const char* message );
+	static U64 AdjustSimulationTargetSample( U64 target_sample, U32 sample_rate, U32 simulation_sample_rate );
+
+	static bool DoesFileExist( const char* file );
+	static void* StartFile( const char* file, bool append = false );
+	static void AppendToFile( U8* data, U32 data_length, void* file );
+	static void EndFile( void* file );
+
+	static S64 ConvertToSignedNumber( U64 number, U32 num_bits );
+};
+
+// space separated text, the way the analyzer settings are stored
+class ANALYZER_EXPORT SimpleArchive
+{
+public:
+	SimpleArchive();
+	~SimpleArchive();
+
+	void SetString( const char* archive_string );
+	const char* GetString();
+
+	bool operator<<( U64 data );
+	bool operator<<( U32 data );
+	bool operator<<( S64 data );
+	bool operator<<( S32 data );
+	bool operator<<( double data );
+	bool operator<<( bool data );
+	bool operator<<( const char* data );
+	bool operator<<( Channel& data );
+
+	bool operator>>( U64& data );
+	bool operator>>( U32& data );
+	bool operator>>( S64& data );
+	bool operator>>( S32& data );
+	bool operator>>( double& data );
+	bool operator>>( bool& data );
+	bool operator>>( char const** data );
+	bool operator>>( Channel& data );
+
+protected:
+	bool NextToken();
+
+	std::string mData;
+	size_t mPosition;
+	std::string mToken;
+};
+
+#endif //ANALYZER_HELPERS_H
@@ -0,0 +1,93 @@
+#ifndef ANALYZER_RESULTS
+#define ANALYZER_RESULTS
+
+#include "AnalyzerTypes.h"
+#include <map>
+#include <string>
+#include <vector>
+
+#define DISPLAY_AS_ERROR_FLAG ( 1 << 7 )
+#define DISPLAY_AS_WARNING_FLAG ( 1 << 6 )
+
+#define INVALID_RESULT_INDEX 0xFFFFFFFFFFFFFFFFull
+
+class ANALYZER_EXPORT Frame
+{
+public:
+	Frame();
+
+	bool HasFlag( U8 flag );
+
+	S64 mStartingSampleInclusive;
+	S64 mEndingSampleInclusive;
+	U64 mData1;
+	U64 mData2;
+	U8 mType;
+	U8 mFlags;
+};
+
+// Keeps frames, packets and transactions in memory like Logic does, so exports work on them.
+// Markers are only counted. The Mock functions report what the analyzer produced.
+
+class ANALYZER_EXPORT AnalyzerResults
+{
+public:
+	enum MarkerType { Dot, ErrorDot, Square, ErrorSquare, UpArrow, DownArrow, X, ErrorX, Start, Stop, One, Zero };
+
+	AnalyzerResults();
+	virtual ~AnalyzerResults();
+
+	virtual void GenerateBubbleText( U64 frame_index, Channel& channel, DisplayBase display_base ) = 0;
+	virtual void GenerateExportFile( const char* file, DisplayBase display_base, U32 export_type_user_id ) = 0;
+	virtual void GenerateFrameTabularText( U64 frame_index, DisplayBase display_base ) = 0;
+	virtual void GeneratePacketTabularText( U64 packet_id, DisplayBase display_base ) = 0;
+	virtual void GenerateTransactionTabularText( U64 transaction_id, DisplayBase display_base ) = 0;
+
+	void AddChannelBubblesWillAppearOn( const Channel& channel );
+
+	U64 AddFrame( const Frame& frame );
+	U64 CommitPacketAndStartNewPacket();
+	void CancelPacketAndStartNewPacket();
+	void AddPacketToTransaction( U64 transaction_id, U64 packet_id );
+	void AddMarker( U64 sample_number, MarkerType marker_type, Channel& channel );
+	void CommitResults();
+
+	U64 GetNumFrames();
+	U64 GetNumPackets();
+	Frame GetFrame( U64 frame_id );
+	U64 GetPacketContainingFrame( U64 frame_id );
+	U64 GetPacketContainingFrameSequential( U64 frame_id );
+	void GetFramesContainedInPacket( U64 packet_id, U64* first_frame_id, U64* last_frame_id );
+	U32 GetTransactionContainingPacket( U64 packet_id );
+	void GetPacketsContainedInTransaction( U64 transaction_id, U64** packet_id_array, U64* packet_id_count );
+
+	void ClearResultStrings();
+	void AddResultString( const char* str1, const char* str2 = NULL, const char* str3 = NULL, const char* str4 = NULL, const char* str5 = NULL, const char* str6 = NULL );
+	bool UpdateExportProgressAndCheckForCancel( U64 completed_frames, U64 total_frames );
+	void ClearTabularText();
+	void AddTabularText( const char* str1, const char* str2 = NULL, const char* str3 = NULL, const char* str4 = NULL, const char* str5 = NULL, const char* str6 = NULL );
+
+	U64 MockGetNumMarkers() const { return mMockMarkers; }
+	U64 MockGetNumErrorMarkers() const { return mMockErrorMarkers; }
+	U64 MockGetNumCommits() const { return mMockCommits; }
+	U64 MockGetMemoryBytes() const;	// frames, packets, transactions and markers, as Logic would store them
+
+protected:
+	struct MockPacket
+	{
+		U64 mFirstFrame;
+		U64 mLastFrame;
+		U64 mTransaction;
+	};
+
+	std::vector< Frame > mMockFrames;
+	std::vector< MockPacket > mMockPackets;
+	std::map< U64, std::vector< U64 > > mMockTransactions;
+	U64 mMockPacketStart;
+	U64 mMockMarkers;
+	U64 mMockErrorMarkers;
+	U64 mMockCommits;
+	std::string mMockString;
+};
+
+#endif //ANALYZER_RESULTS
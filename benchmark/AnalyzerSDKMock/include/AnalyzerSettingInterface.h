@@ -0,0 +1,91 @@
+#ifndef ANALYZER_SETTING_INTERFACE
+#define ANALYZER_SETTING_INTERFACE
+
+#include "AnalyzerTypes.h"
+#include <string>
+#include <vector>
+
+// the interfaces only hold their values, there is no UI
+
+class ANALYZER_EXPORT AnalyzerSettingInterface
+{
+public:
+	AnalyzerSettingInterface() {}
+	virtual ~AnalyzerSettingInterface() {}
+
+	void SetTitleAndTooltip( const char* title, const char* tooltip ) { mTitle = title; mTooltip = tooltip; }
+
+protected:
+	std::string mTitle;
+	std::string mTooltip;
+};
+
+class ANALYZER_EXPORT AnalyzerSettingInterfaceChannel : public AnalyzerSettingInterface
+{
+public:
+	Channel GetChannel() { return mChannel; }
+	void SetChannel( const Channel& channel ) { mChannel = channel; }
+	void SetSelectionOfNoneIsAllowed( bool /*is_allowed*/ ) {}
+
+protected:
+	Channel mChannel;
+};
+
+class ANALYZER_EXPORT AnalyzerSettingInterfaceNumberList : public AnalyzerSettingInterface
+{
+public:
+	AnalyzerSettingInterfaceNumberList() : mNumber( 0.0 ) {}
+
+	double GetNumber() { return mNumber; }
+	void SetNumber( double number ) { mNumber = number; }
+	void AddNumber( double number, const char* /*str*/, const char* /*tooltip*/ ) { mNumbers.push_back( number ); }
+	void ClearNumbers() { mNumbers.clear(); }
+
+protected:
+	double mNumber;
+	std::vector< double > mNumbers;
+};
+
+class ANALYZER_EXPORT AnalyzerSettingInterfaceInteger : public AnalyzerSettingInterface
+{
+public:
+	AnalyzerSettingInterfaceInteger() : mInteger( 0 ), mMax( 0x7FFFFFFF ), mMin( 0 ) {}
+
+	int GetInteger() { return mInteger; }
+	void SetInteger( int integer ) { mInteger = integer; }
+	void SetMax( int max ) { mMax = max; }
+	void SetMin( int min ) { mMin = min; }
+
+protected:
+	int mInteger;
+	int mMax;
+	int mMin;
+};
+
+class ANALYZER_EXPORT AnalyzerSettingInterfaceText : public AnalyzerSettingInterface
+{
+public:
+	enum TextType { NormalText, FilePath, FolderPath };
+
+	const char* GetText() { return mText.c_str(); }
+	void SetText( const char* text ) { mText = text; }
+	void SetTextType( TextType /*text_type*/ ) {}
+
+protected:
+	std::string mText;
+};
+
+class ANALYZER_EXPORT AnalyzerSettingInterfaceBool : public AnalyzerSettingInterface
+{
+public:
+	AnalyzerSettingInterfaceBool() : mValue( false ) {}
+
+	bool GetValue() { return mValue; }
+	void SetValue( bool value ) { mValue = value; }
+	void SetCheckBoxText( const char* /*text*/ ) {}
+
+protected:
+	bool mValue;
+};
+
+#endif //ANALYZER_SETTING_INTERFACE
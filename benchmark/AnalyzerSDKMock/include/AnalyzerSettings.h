@@ -0,0 +1,31 @@
+#ifndef ANALYZER_SETTINGS
+#define ANALYZER_SETTINGS
+
+#include "AnalyzerTypes.h"
+#include "AnalyzerSettingInterface.h"
+#include <memory>
+#include <string>
+
+class ANALYZER_EXPORT AnalyzerSettings
+{
+public:
+	AnalyzerSettings();
+	virtual ~AnalyzerSettings();
+
+	virtual bool SetSettingsFromInterfaces() = 0;
+	virtual void LoadSettings( const char* settings ) = 0;
+	virtual const char* SaveSettings() = 0;
+
+	void ClearChannels();
+	void AddChannel( Channel& channel, const char* channel_label, bool is_used );
+	void SetErrorText( const char* error_text );
+	void AddInterface( AnalyzerSettingInterface* analyzer_setting_interface );
+	void AddExportOption( U32 user_id, const char* menu_text );
+	void AddExportExtension( U32 user_id, const char* extension_description, const char* extension );
+	const char* SetReturnString( const char* str );
+
+protected:
+	std::string mMockReturnString;
+};
+
+#endif //ANALYZER_SETTINGS
@@ -0,0 +1,50 @@
+#ifndef ANALYZER_TYPES
+#define ANALYZER_TYPES
+
+// Stand-in for the Saleae AnalyzerSDK, just enough of it to run the analyzer outside of Logic.
+// Same names and signatures as the SDK; everything that only exists in the mock starts with Mock.
+
+typedef signed char S8;
+typedef signed short S16;
+typedef signed int S32;
+typedef signed long long int S64;
+typedef unsigned char U8;
+typedef unsigned short int U16;
+typedef unsigned int U32;
+typedef unsigned long long int U64;
+
+#ifndef NULL
+#define NULL 0
+#endif
+
+#define ANALYZER_EXPORT
+
+enum BitState { BIT_LOW, BIT_HIGH };
+enum DisplayBase { Binary, Decimal, Hexadecimal, ASCII, AsciiHex };
+
+class Channel
+{
+public:
+	Channel() : mDeviceId( 0 ), mChannelIndex( 0 ) {}
+	Channel( U64 device_id, U32 channel_index ) : mDeviceId( device_id ), mChannelIndex( channel_index ) {}
+
+	bool operator==( const Channel& channel ) const { return ( mDeviceId == channel.mDeviceId ) && ( mChannelIndex == channel.mChannelIndex ); }
+	bool operator!=( const Channel& channel ) const { return !( *this == channel ); }
+
+	U64 mDeviceId;
+	U32 mChannelIndex;
+};
+
+#define UNDEFINED_CHANNEL Channel( 0xFFFFFFFFFFFFFFFFull, 0xFFFFFFFF )
+
+namespace AnalyzerEnums
+{
+	enum ShiftOrder { MsbFirst, LsbFirst };
+	enum EdgeDirection { PosEdge, NegEdge };
+	enum Edge { LeadingEdge, TrailingEdge };
+	enum Parity { None, Even, Odd };
+	enum Acknowledge { Ack, Nak };
+	enum Sign { UnsignedInteger, SignedInteger };
+};
+
+#endif //ANALYZER_TYPES
@@ -0,0 +1,40 @@
+#ifndef SIMULATION_CHANNEL_DESCRIPTOR
+#define SIMULATION_CHANNEL_DESCRIPTOR
+
+#include "AnalyzerTypes.h"
+#include <vector>
+
+// records the simulated edges instead of handing them to Logic
+
+class ANALYZER_EXPORT SimulationChannelDescriptor
+{
+public:
+	SimulationChannelDescriptor();
+
+	void Transition();
+	void TransitionIfNeeded( BitState bit_state );
+	void Advance( U32 num_samples_to_advance );
+
+	BitState GetCurrentBitState();
+	U64 GetCurrentSampleNumber();
+
+	void SetChannel( Channel& channel );
+	void SetSampleRate( U32 sample_rate_hz );
+	void SetInitialBitState( BitState intial_bit_state );
+
+	Channel GetChannel();
+	U32 GetSampleRate();
+	BitState GetInitialBitState();
+
+	const std::vector< U64 >& MockGetEdges() const { return mEdges; }
+
+protected:
+	Channel mChannel;
+	U32 mSampleRateHz;
+	BitState mInitialBitState;
+	BitState mBitState;
+	U64 mSampleNumber;
+	std::vector< U64 > mEdges;
+};
+
+#endif //SIMULATION_CHANNEL_DESCRIPTOR
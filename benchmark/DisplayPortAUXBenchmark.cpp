@@ -0,0 +1,702 @@
+#include "DisplayPortAUXAnalyzer.h"
+#include "DisplayPortAUXAnalyzerSettings.h"
+#include "DisplayPortAUXAnalyzerResults.h"
+#include "DisplayPortAUXTrafficScenario.h"
+#include "DisplayPortAUXLineEncoder.h"
+#include "DisplayPortAUXDeglitchFilter.h"
+#include <AnalyzerChannelData.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Decode benchmark. Runs the analyzer exactly as Logic would, on the mock SDK in AnalyzerSDKMock,
+// over synthetic captures (the simulation's traffic scenarios and line encoder, with jitter and
+// glitches) or over a capture recorded with Logic and exported as CSV. For every combination of
+// bit rate, sample rate, tolerance, glitch rate, polarity, marker density and data frame packing it
+// reports the decode throughput, the decoder's own time per edge, the memory the results take, the
+// time to draw a frame's bubble and tabular text (first and repeated, from the render cache), and
+// the throughput of the exports.
+// Polarity, marker density and clock recovery select different instantiations of the decoder's
+// inner loops, so sweeping them shows what each costs per edge.
+// With more than one decoder thread every case is also decoded serially, the last column shows
+// the first frame where the two differ and the exit code is 2 if any does.
+// Before the cases it checks the deglitch filter on a few edge patterns where the edge it keeps
+// matters, and exits with 3 if one fails.
+// Build with build_benchmark.py, run with --help for the options.
+
+namespace
+{
+	struct Capture
+	{
+		std::vector< U64 > mEdges;
+		BitState mInitialBitState;
+		U64 mEndSample;
+	};
+
+	struct Options
+	{
+		DisplayPortAUXMode mMode;
+		DisplayPortAUXScenarioType mScenario;
+		std::vector< U32 > mBitRates;
+		std::vector< U32 > mSampleRates;
+		std::vector< DisplayPortAUXTolerance > mTolerances;
+		U32 mDeglitchPercent;
+		std::vector< U32 > mGlitchRates;	// per 10000 runs
+		U32 mJitterPercent;
+		U32 mDurationMs;
+		U32 mRepeat;
+		U32 mThreads;
+		std::vector< DisplayPortAUXMarkerDensity > mMarkerDensities;
+		std::vector< U32 > mPolarities;	// 1: inverted
+		std::vector< U32 > mDataFrames;	// 1: up to 16 bytes per frame
+		std::vector< DisplayPortAUXExportType > mExports;
+		std::string mCaptureFile;
+		std::string mExportFile;
+	};
+
+	// one row of the table
+	struct Case
+	{
+		U32 mBitRate;
+		U32 mSampleRate;
+		DisplayPortAUXTolerance mTolerance;
+		DisplayPortAUXMarkerDensity mMarkerDensity;
+		bool mInverted;
+		bool mPackDataFrames;
+		std::string mGlitches;
+	};
+
+	enum { RenderFrames = 2000, RenderPasses = 8 };
+
+	struct Result
+	{
+		double mDecodeSeconds;
+		double mDecoderNsPerEdge;	// the decoder's own time, without the wait for edges and the SDK
+		U64 mFrames;
+		U64 mPackets;
+		U64 mErrors;
+		U64 mMemoryBytes;
+		double mRenderNs;	// bubble and tabular text of one frame, formatted
+		double mCachedRenderNs;	// the same, drawn again
+		std::vector< double > mExportSeconds;
+		std::vector< U64 > mExportBytes;
+		U64 mFirstDifference;	// frame index, against the serial decoder when there are several threads
+	};
+
+	const U64 NoDifference = ~U64( 0 );
+
+	// exposes what WorkerThread() produced
+	class BenchmarkAnalyzer : public DisplayPortAUXAnalyzer
+	{
+	public:
+		DisplayPortAUXAnalyzerSettings* GetSettings() { return mSettings.get(); }
+		DisplayPortAUXAnalyzerResults* GetResults() { return mResults.get(); }
+	};
+
+	struct Name
+	{
+		const char* mName;
+		U32 mValue;
+	};
+
+	const Name gModes[] = { { "manchester", Manchester }, { "faux", FAUX } };
+	const Name gScenarios[] =
+	{
+		{ "counter", ScenarioCounter }, { "mixed", ScenarioMixed }, { "native", ScenarioNativeAux },
+		{ "defer", ScenarioDeferStorm }, { "edid", ScenarioEdidRead }, { "training", ScenarioLinkTraining }
+	};
+	const Name gTolerances[] = { { "TOL25", TOL25 }, { "TOL5", TOL5 }, { "TOL05", TOL05 }, { "RECOVERED", TOLRECOVERED } };
+	const Name gMarkers[] = { { "all", MarkersAllBits }, { "startstop", MarkersStartStopErrors }, { "none", MarkersNone } };
+	const Name gPolarities[] = { { "normal", 0 }, { "inverted", 1 } };
+	const Name gDataFrames[] = { { "byte", 0 }, { "packed", 1 } };
+	const Name gExports[] =
+	{
+		{ "dmp", DpAuxDMP }, { "txt", DpAuxTXT }, { "dpcd", DpAuxDPCD }, { "edid", DpAuxEDID },
+		{ "bin", DpAuxBIN }, { "pcapng", DpAuxPCAPNG }, { "stats", DpAuxSTATS }, { "debug", DpAuxDEBUG }
+	};
+
+	template< size_t N > bool FindValue( const Name ( &names )[ N ], const std::string& name, U32& value )
+	{
+		for( size_t i = 0; i < N; ++i )
+		{
+			if( name == names[ i ].mName )
+			{
+				value = names[ i ].mValue;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template< size_t N > const char* FindName( const Name ( &names )[ N ], U32 value )
+	{
+		for( size_t i = 0; i < N; ++i )
+		{
+			if( names[ i ].mValue == value )
+				return names[ i ].mName;
+		}
+		return "?";
+	}
+
+	std::vector< std::string > SplitList( const std::string& list )
+	{
+		std::vector< std::string > items;
+		std::istringstream stream( list );
+		std::string item;
+		while( std::getline( stream, item, ',' ) )
+		{
+			if( item.empty() == false )
+				items.push_back( item );
+		}
+		return items;
+	}
+
+	void PrintUsage()
+	{
+		printf(
+			"usage: DisplayPortAUXBenchmark [options]\n"
+			"  --mode manchester|faux          line code (manchester)\n"
+			"  --scenario NAME                 counter, mixed, native, defer, edid, training (mixed)\n"
+			"  --bit-rates LIST                bits/s (1000000)\n"
+			"  --sample-rates LIST             Hz (10000000,25000000,100000000,500000000)\n"
+			"  --tolerances LIST               TOL25, TOL5, TOL05, RECOVERED (TOL25,TOL5,TOL05)\n"
+			"  --deglitch PERCENT              deglitch filter, %% of a half bit, 0 = off (0)\n"
+			"  --glitches LIST                 glitches per 10000 runs, the error density (0,10,100)\n"
+			"  --jitter PERCENT                edge jitter, %% of a half bit (5)\n"
+			"  --duration-ms MS                length of every synthetic capture (1000)\n"
+			"  --repeat N                      decode N times, report the fastest (3)\n"
+			"  --threads N                     decoder threads, 0 = one per core (1)\n"
+			"  --markers LIST                  marker density: all, startstop, none (all)\n"
+			"  --polarity LIST                 normal, inverted (normal)\n"
+			"  --data-frames LIST              byte (one frame per data byte), packed (up to 16) (byte)\n"
+			"  --exports LIST|none             dmp, txt, dpcd, edid, bin, pcapng, stats, debug (txt,bin,pcapng)\n"
+			"  --export-file PATH              scratch file for the exports (benchmark_export.tmp)\n"
+			"  --capture FILE                  decode a Logic CSV export (time [s], level) instead,\n"
+			"                                  at the first of --sample-rates\n" );
+	}
+
+	bool ParseOptions( int argc, char** argv, Options& options )
+	{
+		options.mMode = Manchester;
+		options.mScenario = ScenarioMixed;
+		options.mBitRates.push_back( 1000000 );
+		options.mSampleRates.push_back( 10000000 );
+		options.mSampleRates.push_back( 25000000 );
+		options.mSampleRates.push_back( 100000000 );
+		options.mSampleRates.push_back( 500000000 );
+		options.mTolerances.push_back( TOL25 );
+		options.mTolerances.push_back( TOL5 );
+		options.mTolerances.push_back( TOL05 );
+		options.mDeglitchPercent = 0;
+		options.mGlitchRates.push_back( 0 );
+		options.mGlitchRates.push_back( 10 );
+		options.mGlitchRates.push_back( 100 );
+		options.mJitterPercent = 5;
+		options.mDurationMs = 1000;
+		options.mRepeat = 3;
+		options.mThreads = 1;
+		options.mMarkerDensities.push_back( MarkersAllBits );
+		options.mPolarities.push_back( 0 );
+		options.mDataFrames.push_back( 0 );
+		options.mExports.push_back( DpAuxTXT );
+		options.mExports.push_back( DpAuxBIN );
+		options.mExports.push_back( DpAuxPCAPNG );
+		options.mExportFile = "benchmark_export.tmp";
+
+		for( int i = 1; i < argc; ++i )
+		{
+			std::string option = argv[ i ];
+			if( ( option == "--help" ) || ( option == "-h" ) || ( i + 1 >= argc ) )
+				return false;
+
+			std::string value = argv[ ++i ];
+			std::vector< std::string > list = SplitList( value );
+			U32 number;
+
+			if( option == "--mode" )
+			{
+				if( FindValue( gModes, value, number ) == false )
+					return false;
+				options.mMode = DisplayPortAUXMode( number );
+			}
+			else if( option == "--scenario" )
+			{
+				if( FindValue( gScenarios, value, number ) == false )
+					return false;
+				options.mScenario = DisplayPortAUXScenarioType( number );
+			}
+			else if( ( option == "--bit-rates" ) || ( option == "--sample-rates" ) || ( option == "--glitches" ) )
+			{
+				std::vector< U32 >& numbers = ( option == "--bit-rates" ) ? options.mBitRates : ( option == "--sample-rates" ) ? options.mSampleRates : options.mGlitchRates;
+				numbers.clear();
+				for( size_t j = 0; j < list.size(); ++j )
+					numbers.push_back( U32( strtoul( list[ j ].c_str(), NULL, 10 ) ) );
+				if( numbers.empty() == true )
+					return false;
+			}
+			else if( option == "--tolerances" )
+			{
+				options.mTolerances.clear();
+				for( size_t j = 0; j < list.size(); ++j )
+				{
+					if( FindValue( gTolerances, list[ j ], number ) == false )
+						return false;
+					options.mTolerances.push_back( DisplayPortAUXTolerance( number ) );
+				}
+				if( options.mTolerances.empty() == true )
+					return false;
+			}
+			else if( option == "--exports" )
+			{
+				options.mExports.clear();
+				for( size_t j = 0; ( j < list.size() ) && ( value != "none" ); ++j )
+				{
+					if( FindValue( gExports, list[ j ], number ) == false )
+						return false;
+					options.mExports.push_back( DisplayPortAUXExportType( number ) );
+				}
+			}
+			else if( option == "--markers" )
+			{
+				options.mMarkerDensities.clear();
+				for( size_t j = 0; j < list.size(); ++j )
+				{
+					if( FindValue( gMarkers, list[ j ], number ) == false )
+						return false;
+					options.mMarkerDensities.push_back( DisplayPortAUXMarkerDensity( number ) );
+				}
+				if( options.mMarkerDensities.empty() == true )
+					return false;
+			}
+			else if( option == "--polarity" )
+			{
+				options.mPolarities.clear();
+				for( size_t j = 0; j < list.size(); ++j )
+				{
+					if( FindValue( gPolarities, list[ j ], number ) == false )
+						return false;
+					options.mPolarities.push_back( number );
+				}
+				if( options.mPolarities.empty() == true )
+					return false;
+			}
+			else if( option == "--data-frames" )
+			{
+				options.mDataFrames.clear();
+				for( size_t j = 0; j < list.size(); ++j )
+				{
+					if( FindValue( gDataFrames, list[ j ], number ) == false )
+						return false;
+					options.mDataFrames.push_back( number );
+				}
+				if( options.mDataFrames.empty() == true )
+					return false;
+			}
+			else if( option == "--deglitch" )
+				options.mDeglitchPercent = U32( strtoul( value.c_str(), NULL, 10 ) );
+			else if( option == "--jitter" )
+				options.mJitterPercent = U32( strtoul( value.c_str(), NULL, 10 ) );
+			else if( option == "--duration-ms" )
+				options.mDurationMs = U32( strtoul( value.c_str(), NULL, 10 ) );
+			else if( option == "--repeat" )
+				options.mRepeat = U32( strtoul( value.c_str(), NULL, 10 ) );
+			else if( option == "--threads" )
+				options.mThreads = U32( strtoul( value.c_str(), NULL, 10 ) );
+			else if( option == "--export-file" )
+				options.mExportFile = value;
+			else if( option == "--capture" )
+				options.mCaptureFile = value;
+			else
+				return false;
+		}
+
+		if( options.mRepeat == 0 )
+			options.mRepeat = 1;
+		return true;
+	}
+
+	void MakeCapture( const Options& options, U32 bit_rate, U32 sample_rate, U32 glitch_rate, bool inverted, Capture& capture )
+	{
+		bool faux = options.mMode == FAUX;
+		DisplayPortAUXTrafficScenario scenario;
+		DisplayPortAUXLineEncoder encoder;
+		scenario.Init( options.mScenario, bit_rate, faux ? 16 : 8 );
+		encoder.Init( sample_rate, bit_rate, faux, inverted, false, options.mJitterPercent, glitch_rate );
+		encoder.AddIdleHalfBits( 16 );
+
+		U64 end_sample = U64( sample_rate ) * options.mDurationMs / 1000;
+		while( encoder.GetSettledSample() < end_sample )
+		{
+			const DisplayPortAUXSimBurst& burst = scenario.NextBurst();
+			encoder.AddBurst( burst.mBytes.empty() ? NULL : &burst.mBytes[ 0 ], U32( burst.mBytes.size() ) );
+			encoder.AddIdleNs( burst.mIdleNs );
+		}
+
+		capture.mEdges.swap( encoder.GetEdges() );
+		capture.mInitialBitState = encoder.IsInitiallyHigh() ? BIT_HIGH : BIT_LOW;
+		capture.mEndSample = encoder.GetSettledSample();
+	}
+
+	bool LoadCapture( const std::string& file, U32 sample_rate, Capture& capture )
+	{
+		// Logic's digital CSV export: a header line, then "time [s], level" at every change
+		std::ifstream stream( file.c_str() );
+		if( stream.is_open() == false )
+			return false;
+
+		std::string line;
+		std::getline( stream, line );
+		capture.mEdges.clear();
+		capture.mEndSample = 0;
+
+		bool first = true;
+		double start_time = 0.0;
+		int level = 0;
+		while( std::getline( stream, line ) )
+		{
+			double time;
+			int value;
+			if( sscanf( line.c_str(), "%lf , %d", &time, &value ) != 2 )
+				continue;
+
+			if( first == true )
+			{
+				start_time = time;
+				level = value;
+				capture.mInitialBitState = ( value != 0 ) ? BIT_HIGH : BIT_LOW;
+				first = false;
+				continue;
+			}
+			if( value == level )
+				continue;
+
+			level = value;
+			U64 sample = U64( std::floor( ( time - start_time ) * double( sample_rate ) + 0.5 ) );
+			if( ( capture.mEdges.empty() == false ) && ( sample <= capture.mEdges.back() ) )
+				sample = capture.mEdges.back() + 1;	// too close for this sample rate
+			capture.mEdges.push_back( sample );
+		}
+
+		if( first == true )
+			return false;
+		capture.mEndSample = ( capture.mEdges.empty() ? 0 : capture.mEdges.back() ) + sample_rate / 1000;	// 1 ms of idle line after the last edge
+		return true;
+	}
+
+	double Seconds( std::chrono::steady_clock::time_point start )
+	{
+		return std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+	}
+
+	// draws a screen of frames from the middle of the results, like panning over them in Logic
+	void Render( DisplayPortAUXAnalyzerResults* results, Result& result )
+	{
+		U64 num_frames = results->GetNumFrames();
+		U64 count = ( num_frames < U64( RenderFrames ) ) ? num_frames : U64( RenderFrames );
+		U64 first = ( num_frames - count ) / 2;
+		Channel channel( 0, 0 );
+
+		result.mRenderNs = 0.0;
+		result.mCachedRenderNs = 0.0;
+		if( count == 0 )
+			return;
+
+		for( U32 pass = 0; pass <= RenderPasses; ++pass )
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for( U64 i = first; i < first + count; ++i )
+			{
+				results->GenerateBubbleText( i, channel, Hexadecimal );
+				results->GenerateFrameTabularText( i, Hexadecimal );
+			}
+			double ns = Seconds( start ) * 1e9 / double( count );
+			if( pass == 0 )
+				result.mRenderNs = ns;
+			else
+				result.mCachedRenderNs += ns / RenderPasses;
+		}
+	}
+
+	// decodes the whole capture, returns the seconds it took
+	double RunAnalyzer( const Options& options, const Capture& capture, const Case& row, U32 threads, BenchmarkAnalyzer& analyzer )
+	{
+		DisplayPortAUXAnalyzerSettings* settings = analyzer.GetSettings();
+		settings->mInputChannel = Channel( 0, 0 );
+		settings->mMode = options.mMode;
+		settings->mBitRate = row.mBitRate;
+		settings->mInverted = row.mInverted;
+		settings->mTolerance = row.mTolerance;
+		settings->mDeglitchPercent = options.mDeglitchPercent;
+		settings->mMarkerDensity = row.mMarkerDensity;
+		settings->mPackDataFrames = row.mPackDataFrames;
+		settings->mDecodeThreads = threads;
+
+		AnalyzerChannelData channel_data( capture.mEdges, capture.mInitialBitState, capture.mEndSample );
+		analyzer.MockSetChannelData( &channel_data, row.mSampleRate );
+		analyzer.SetupResults();
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		try
+		{
+			analyzer.WorkerThread();
+		}
+		catch( MockEndOfData& )
+		{
+		}
+		return Seconds( start );
+	}
+
+	// the parallel decoder must produce exactly the serial decoder's frames, packets and markers
+	U64 FindDifference( DisplayPortAUXAnalyzerResults* results, DisplayPortAUXAnalyzerResults* serial )
+	{
+		U64 num_frames = results->GetNumFrames();
+		U64 serial_frames = serial->GetNumFrames();
+		for( U64 i = 0; ( i < num_frames ) && ( i < serial_frames ); ++i )
+		{
+			Frame frame = results->GetFrame( i );
+			Frame serial_frame = serial->GetFrame( i );
+			if( ( frame.mStartingSampleInclusive != serial_frame.mStartingSampleInclusive ) || ( frame.mEndingSampleInclusive != serial_frame.mEndingSampleInclusive ) ||
+				( frame.mData1 != serial_frame.mData1 ) || ( frame.mData2 != serial_frame.mData2 ) || ( frame.mType != serial_frame.mType ) || ( frame.mFlags != serial_frame.mFlags ) )
+				return i;
+		}
+		if( num_frames != serial_frames )
+			return ( num_frames < serial_frames ) ? num_frames : serial_frames;
+		if( ( results->GetNumPackets() != serial->GetNumPackets() ) || ( results->MockGetNumMarkers() != serial->MockGetNumMarkers() ) )
+			return num_frames;
+		return NoDifference;
+	}
+
+	// edges in, the edges the deglitch filter must hand on (both end with 0), 10 samples minimum width
+	struct DeglitchCase
+	{
+		const char* mName;
+		U64 mEdges[ 8 ];
+		U64 mExpected[ 8 ];
+	};
+
+	bool CheckDeglitchFilter()
+	{
+		static const DeglitchCase cases[] =
+		{
+			{ "glitch on a quiet line", { 100, 103, 200, 0 }, { 200, 0 } },
+			{ "glitch right after a real edge", { 100, 101, 102, 200, 0 }, { 100, 200, 0 } },
+			{ "wider glitch right after a real edge", { 100, 104, 108, 200, 0 }, { 100, 200, 0 } },
+			{ "glitch in a short run", { 100, 120, 125, 126, 140, 0 }, { 100, 120, 140, 0 } }
+		};
+
+		bool passed = true;
+		for( size_t c = 0; c < sizeof( cases ) / sizeof( cases[ 0 ] ); ++c )
+		{
+			U64 count = 0;
+			while( cases[ c ].mEdges[ count ] != 0 )
+				++count;
+			DisplayPortAUXArrayEdgeSource source( cases[ c ].mEdges, count, false );
+			DisplayPortAUXDeglitchFilter filter( &source, 10 );
+
+			U64 edges[ 8 ];
+			U32 num_edges = 0;
+			for( ; ; )
+			{
+				U32 read = filter.ReadEdges( edges + num_edges, 7 - num_edges );
+				if( read == 0 )
+					break;
+				num_edges += read;
+			}
+
+			bool match = cases[ c ].mExpected[ num_edges ] == 0;
+			for( U32 i = 0; i < num_edges; ++i )
+				if( edges[ i ] != cases[ c ].mExpected[ i ] )
+					match = false;
+			if( match == false )
+			{
+				fprintf( stderr, "deglitch filter: %s fails\n", cases[ c ].mName );
+				passed = false;
+			}
+		}
+		return passed;
+	}
+
+	void Decode( const Options& options, const Capture& capture, const Case& row, Result& result )
+	{
+		result.mDecodeSeconds = 0.0;
+		result.mFirstDifference = NoDifference;
+		for( U32 run = 0; run < options.mRepeat; ++run )
+		{
+			BenchmarkAnalyzer analyzer;
+			double seconds = RunAnalyzer( options, capture, row, options.mThreads, analyzer );
+
+			DisplayPortAUXAnalyzerResults* results = analyzer.GetResults();
+			if( ( run == 0 ) || ( seconds < result.mDecodeSeconds ) )
+			{
+				result.mDecodeSeconds = seconds;
+				result.mFrames = results->GetNumFrames();
+				result.mPackets = results->GetNumPackets();
+				result.mErrors = results->MockGetNumErrorMarkers();
+				result.mMemoryBytes = results->MockGetMemoryBytes();
+
+				DisplayPortAUXDecoderCounters counters = results->GetStatistics()->GetSummary().mDecoder;
+				result.mDecoderNsPerEdge = ( counters.mEdges != 0 ) ? double( counters.mDecodeNs ) / double( counters.mEdges ) : 0.0;
+			}
+
+			if( run + 1 != options.mRepeat )
+				continue;
+
+			if( options.mThreads != 1 )
+			{
+				BenchmarkAnalyzer serial;
+				RunAnalyzer( options, capture, row, 1, serial );
+				result.mFirstDifference = FindDifference( results, serial.GetResults() );
+			}
+
+			Render( results, result );
+
+			// the exports work on the results of the last run
+			result.mExportSeconds.clear();
+			result.mExportBytes.clear();
+			for( size_t i = 0; i < options.mExports.size(); ++i )
+			{
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				results->GenerateExportFile( options.mExportFile.c_str(), Hexadecimal, options.mExports[ i ] );
+				result.mExportSeconds.push_back( Seconds( start ) );
+
+				std::ifstream exported( options.mExportFile.c_str(), std::ios::binary | std::ios::ate );
+				result.mExportBytes.push_back( exported.is_open() ? U64( exported.tellg() ) : 0 );
+			}
+			remove( options.mExportFile.c_str() );
+		}
+	}
+
+	void PrintHeader( const Options& options )
+	{
+		printf( "%-10s %9s %10s %-9s %-9s %-9s %-6s %7s %9s %9s %7s %9s %8s %11s %8s %10s %9s %9s",
+			"mode", "bit rate", "samp rate", "tolerance", "polarity", "markers", "data", "glitch", "edges", "frames", "errors", "decode ms", "Medges/s", "dec ns/edge", "kframe/s", "result KB", "render ns", "cached ns" );
+		for( size_t i = 0; i < options.mExports.size(); ++i )
+			printf( " %6s MB/s", FindName( gExports, options.mExports[ i ] ) );
+		if( options.mThreads != 1 )
+			printf( " %10s", "vs serial" );
+		printf( "\n" );
+	}
+
+	void PrintResult( const Options& options, const Capture& capture, const Case& row, const Result& result )
+	{
+		double seconds = ( result.mDecodeSeconds > 0.0 ) ? result.mDecodeSeconds : 1e-9;
+		printf( "%-10s %9u %10u %-9s %-9s %-9s %-6s %7s %9llu %9llu %7llu %9.2f %8.2f %11.2f %8.1f %10.1f %9.1f %9.1f",
+			FindName( gModes, options.mMode ), row.mBitRate, row.mSampleRate, FindName( gTolerances, row.mTolerance ),
+			FindName( gPolarities, row.mInverted ? 1 : 0 ), FindName( gMarkers, row.mMarkerDensity ),
+			FindName( gDataFrames, row.mPackDataFrames ? 1 : 0 ), row.mGlitches.c_str(),
+			U64( capture.mEdges.size() ), result.mFrames, result.mErrors, seconds * 1000.0,
+			double( capture.mEdges.size() ) / seconds / 1e6, result.mDecoderNsPerEdge, double( result.mFrames ) / seconds / 1e3, double( result.mMemoryBytes ) / 1024.0,
+			result.mRenderNs, result.mCachedRenderNs );
+		for( size_t i = 0; i < result.mExportSeconds.size(); ++i )
+		{
+			double export_seconds = ( result.mExportSeconds[ i ] > 0.0 ) ? result.mExportSeconds[ i ] : 1e-9;
+			printf( " %11.1f", double( result.mExportBytes[ i ] ) / export_seconds / 1e6 );
+		}
+		if( options.mThreads != 1 )
+		{
+			if( result.mFirstDifference == NoDifference )
+				printf( " %10s", "same" );
+			else
+				printf( " %10llu", result.mFirstDifference );	// index of the first frame that differs
+		}
+		printf( "\n" );
+		fflush( stdout );
+	}
+
+	// every tolerance, marker density and data frame packing on one capture, false if the parallel decoder's output differed
+	bool RunCases( const Options& options, const Capture& capture, Case& row )
+	{
+		bool identical = true;
+		for( size_t t = 0; t < options.mTolerances.size(); ++t )
+		{
+			for( size_t m = 0; m < options.mMarkerDensities.size(); ++m )
+			{
+				for( size_t d = 0; d < options.mDataFrames.size(); ++d )
+				{
+					row.mTolerance = options.mTolerances[ t ];
+					row.mMarkerDensity = options.mMarkerDensities[ m ];
+					row.mPackDataFrames = options.mDataFrames[ d ] != 0;
+
+					Result result;
+					Decode( options, capture, row, result );
+					PrintResult( options, capture, row, result );
+					if( result.mFirstDifference != NoDifference )
+						identical = false;
+				}
+			}
+		}
+		return identical;
+	}
+}
+
+int main( int argc, char** argv )
+{
+	Options options;
+	if( ParseOptions( argc, argv, options ) == false )
+	{
+		PrintUsage();
+		return 1;
+	}
+	if( CheckDeglitchFilter() == false )
+		return 3;	// 3: the deglitch filter moves or keeps edges it must not
+
+	PrintHeader( options );
+
+	Case row;
+	bool identical = true;
+	if( options.mCaptureFile.empty() == false )
+	{
+		Capture capture;
+		row.mSampleRate = options.mSampleRates[ 0 ];
+		row.mGlitches = "capture";
+		if( LoadCapture( options.mCaptureFile, row.mSampleRate, capture ) == false )
+		{
+			fprintf( stderr, "can't read %s\n", options.mCaptureFile.c_str() );
+			return 1;
+		}
+
+		for( size_t b = 0; b < options.mBitRates.size(); ++b )
+		{
+			for( size_t p = 0; p < options.mPolarities.size(); ++p )
+			{
+				row.mBitRate = options.mBitRates[ b ];
+				row.mInverted = options.mPolarities[ p ] != 0;	// the capture is decoded as either
+				if( RunCases( options, capture, row ) == false )
+					identical = false;
+			}
+		}
+		return identical ? 0 : 2;
+	}
+
+	for( size_t b = 0; b < options.mBitRates.size(); ++b )
+	{
+		for( size_t s = 0; s < options.mSampleRates.size(); ++s )
+		{
+			for( size_t g = 0; g < options.mGlitchRates.size(); ++g )
+			{
+				for( size_t p = 0; p < options.mPolarities.size(); ++p )
+				{
+					row.mBitRate = options.mBitRates[ b ];
+					row.mSampleRate = options.mSampleRates[ s ];
+					row.mInverted = options.mPolarities[ p ] != 0;
+
+					char glitches[ 16 ];
+					snprintf( glitches, sizeof( glitches ), "%u", options.mGlitchRates[ g ] );
+					row.mGlitches = glitches;
+
+					Capture capture;
+					MakeCapture( options, row.mBitRate, row.mSampleRate, options.mGlitchRates[ g ], row.mInverted, capture );
+					if( RunCases( options, capture, row ) == false )
+						identical = false;
+				}
+			}
+		}
+	}
+	return identical ? 0 : 2;	// 2: the parallel decoder differs from the serial one
+}
@@ -0,0 +1,54 @@
+# Python 3 script to build the decode benchmark
+# The analyzer sources are compiled against the mock SDK in benchmark/AnalyzerSDKMock instead of the
+# AnalyzerSDK submodule, so the benchmark runs without Logic. The result is benchmark/release/DisplayPortAUXBenchmark.
+
+import os, glob, platform
+
+print("Running on " + platform.system())
+
+#make sure the output folder exists, and clean out any .o files if there are any
+output_folder = "benchmark/release"
+if not os.path.exists( output_folder ):
+    os.makedirs( output_folder )
+
+for o_file in glob.glob( output_folder + "/*.o" ):
+    os.remove( o_file )
+
+#the analyzer, the mock SDK and the benchmark itself
+cpp_files = glob.glob( "source/*.cpp" )
+cpp_files.extend( glob.glob( "benchmark/AnalyzerSDKMock/*.cpp" ) )
+cpp_files.extend( glob.glob( "benchmark/*.cpp" ) )
+
+#specify the search paths/options for gcc
+include_paths = [ "./benchmark/AnalyzerSDKMock/include", "./source" ]
+link_dependencies = [ "-lpthread" ]
+
+compile_flags = "-std=c++11 -O3 -g -Wall -Wextra -Wformat -Wno-unknown-pragmas -Wno-deprecated-declarations -c"
+
+def run_command(cmd):
+    "Display cmd, then run it in a subshell, raise if there's an error"
+    print(cmd)
+    if os.system(cmd):
+        raise Exception("Shell execution returned nonzero status")
+
+#compile each cpp file
+o_files = []
+for cpp_file in cpp_files:
+    o_file = output_folder + "/" + os.path.basename( cpp_file ).replace( ".cpp", ".o" )
+    o_files.append( o_file )
+
+    command = "g++ "
+    for path in include_paths:
+        command += "-I\"" + path + "\" "
+    command += compile_flags
+    command += " -o\"" + o_file + "\" " #the output file
+    command += "\"" + cpp_file + "\"" #the cpp file to compile
+    run_command(command)
+
+#lastly, link
+command = "g++ -o\"" + output_folder + "/DisplayPortAUXBenchmark\" "
+for o_file in o_files:
+    command += "\"" + o_file + "\" "
+for link_dependency in link_dependencies:
+    command += link_dependency + " "
+run_command(command)
@@ -0,0 +1,104 @@
+#include "DisplayPortAUX8b10b.h"
+
+// sub-block codes for a negative running disparity, first transmitted bit is the MSB
+static const U8 g5b6b[ 32 ] =
+{
+	0x27, 0x1D, 0x2D, 0x31, 0x35, 0x29, 0x19, 0x38,	// 100111 011101 101101 110001 110101 101001 011001 111000
+	0x39, 0x25, 0x15, 0x34, 0x0D, 0x2C, 0x1C, 0x17,	// 111001 100101 010101 110100 001101 101100 011100 010111
+	0x1B, 0x23, 0x13, 0x32, 0x0B, 0x2A, 0x1A, 0x3A,	// 011011 100011 010011 110010 001011 101010 011010 111010
+	0x33, 0x26, 0x16, 0x36, 0x0E, 0x2E, 0x1E, 0x2B	// 110011 100110 010110 110110 001110 101110 011110 101011
+};
+static const U8 gK28_6b = 0x0F;	// 001111
+static const U8 g3b4bData[ 8 ] = { 0xB, 0x9, 0x5, 0xC, 0xD, 0xA, 0x6, 0xE };	// 1011 1001 0101 1100 1101 1010 0110 1110(P7)
+static const U8 g3b4bControl[ 8 ] = { 0xB, 0x6, 0xA, 0xC, 0xD, 0x5, 0x9, 0x7 };	// K28.y, always complemented for a positive disparity
+static const U8 gA7 = 0x7;	// 0111
+static const U8 gControlSymbols[] = { 0x1C, 0x3C, 0x5C, 0x7C, 0x9C, 0xBC, 0xDC, 0xFC, 0xF7, 0xFB, 0xFD, 0xFE };	// K28.0-7, K23.7, K27.7, K29.7, K30.7
+
+static U32 CountOnes( U32 value )
+{
+	U32 count = 0;
+	for( ; value != 0; value >>= 1 )
+		count += value & 1;
+	return count;
+}
+
+static U32 Encode6b( U32 x, bool control, bool rd_positive )
+{
+	U32 code = ( control == true ) && ( x == 28 ) ? gK28_6b : g5b6b[ x ];
+	if( ( rd_positive == true ) && ( ( CountOnes( code ) != 3 ) || ( code == 0x38 ) ) )	// D.07 is balanced but still alternates
+		code ^= 0x3F;
+	return code;
+}
+
+static U32 Encode4b( U32 x, U32 y, bool control, bool rd_positive )
+{
+	U32 code;
+	if( ( control == true ) && ( x == 28 ) )
+	{
+		code = g3b4bControl[ y ];
+		if( rd_positive == true )
+			code ^= 0xF;
+		return code;
+	}
+
+	if( y == 7 )
+	{
+		bool alternate = ( control == true ) ||
+			( ( rd_positive == false ) && ( ( x == 17 ) || ( x == 18 ) || ( x == 20 ) ) ) ||
+			( ( rd_positive == true ) && ( ( x == 11 ) || ( x == 13 ) || ( x == 14 ) ) );	// avoids a run of 5 across the sub-blocks
+		code = ( alternate == true ) ? gA7 : g3b4bData[ 7 ];
+	}
+	else
+	{
+		code = g3b4bData[ y ];
+	}
+
+	if( ( rd_positive == true ) && ( ( CountOnes( code ) != 2 ) || ( code == 0xC ) ) )	// D.x.3 is balanced but still alternates
+		code ^= 0xF;
+	return code;
+}
+
+DisplayPortAUX8b10b::Tables::Tables()
+{
+	for( U32 i = 0; i < 1024; ++i )
+		mDecode[ i ] = Invalid;
+	for( U32 i = 0; i < 512; ++i )
+		mEncode[ 0 ][ i ] = mEncode[ 1 ][ i ] = Invalid;
+
+	for( U32 symbol = 0; symbol < 256 + sizeof( gControlSymbols ); ++symbol )
+	{
+		bool control = symbol >= 256;
+		U32 value = ( control == true ) ? gControlSymbols[ symbol - 256 ] : symbol;
+		U32 x = value & 0x1F;
+		U32 y = value >> 5;
+		U32 index = value | ( ( control == true ) ? KFlag : 0 );
+
+		for( U32 rd = 0; rd < 2; ++rd )
+		{
+			U32 code6 = Encode6b( x, control, rd != 0 );
+			bool rd_after_6b = ( CountOnes( code6 ) == 3 ) ? ( rd != 0 ) : ( CountOnes( code6 ) > 3 );
+			U32 code = ( code6 << 4 ) | Encode4b( x, y, control, rd_after_6b );
+
+			mEncode[ rd ][ index ] = U16( code );
+			mDecode[ code ] = U16( index );
+		}
+	}
+}
+
+const DisplayPortAUX8b10b::Tables& DisplayPortAUX8b10b::GetTables()
+{
+	static const Tables tables;
+	return tables;
+}
+
+U16 DisplayPortAUX8b10b::Encode( U16 symbol, bool& rd_positive )
+{
+	U16 code = GetTables().mEncode[ rd_positive ? 1 : 0 ][ symbol & 0x1FF ];
+	if( code == Invalid )
+		return Invalid;
+
+	U32 ones = CountOnes( code );
+	if( ones != 5 )
+		rd_positive = ones > 5;
+	return code;
+}
@@ -0,0 +1,42 @@
+#ifndef DISPLAYPORTAUX_8B10B
+#define DISPLAYPORTAUX_8B10B
+
+#include "DisplayPortAUXTypes.h"
+
+// 8b/10b line code tables. A 10 bit code is stored with the first transmitted bit ("a") in bit 9,
+// i.e. in the order the bits are shifted in from the line. Both tables are built once from the
+// 5b/6b and 3b/4b sub-block codes, so decoding is a single lookup.
+
+class DisplayPortAUX8b10b
+{
+public:
+	enum
+	{
+		KFlag = 0x100,		// control symbol
+		Invalid = 0xFFFF,	// not a code word in either disparity
+
+		K28_5 = KFlag | 0xBC,	// comma, used for symbol alignment
+		K27_7 = KFlag | 0xFB,
+		K29_7 = KFlag | 0xFD,
+		K30_7 = KFlag | 0xFE
+	};
+
+	// value | KFlag for a valid code word, Invalid otherwise
+	static U16 Decode( U32 code ) { return GetTables().mDecode[ code & 0x3FF ]; }
+
+	// symbol is a byte, or a byte | KFlag; rd_positive is the running disparity, updated
+	static U16 Encode( U16 symbol, bool& rd_positive );
+
+protected:
+	struct Tables
+	{
+		Tables();
+
+		U16 mDecode[ 1024 ];
+		U16 mEncode[ 2 ][ 512 ];	// [ rd_positive ][ symbol ], Invalid for the unused K codes
+	};
+
+	static const Tables& GetTables();
+};
+
+#endif //DISPLAYPORTAUX_8B10B
@@ -6,12 +6,18 @@
 
 #include "DisplayPortAUXAnalyzer.h"
 #include "DisplayPortAUXAnalyzerSettings.h"  
+#include "DisplayPortAUXChannelAdapter.h"
+#include "DisplayPortAUXBitRateDetector.h"
+#include "DisplayPortAUXDeglitchFilter.h"
+#include "DisplayPortAUXDecoder.h"
+#include "DisplayPortAUXFauxDecoder.h"
+#include "DisplayPortAUXParallelDecoder.h"
 #include <AnalyzerChannelData.h>
 
 
 DisplayPortAUXAnalyzer::DisplayPortAUXAnalyzer()
-:	mSettings( new DisplayPortAUXAnalyzerSettings() ),
-	Analyzer2(),
+:	Analyzer2(),
+	mSettings( new DisplayPortAUXAnalyzerSettings() ),
 	mSimulationInitilized( false )
 {
 	SetAnalyzerSettings( mSettings.get() );
@@ -29,6 +35,16 @@ void DisplayPortAUXAnalyzer::SetupResults()
 	mResults->AddChannelBubblesWillAppearOn( mSettings->mInputChannel );
 }
 
+static DisplayPortAUXDecoder* CreateManchesterDecoder( const DisplayPortAUXDecoderConfig& config, DisplayPortAUXEdgeSource* source, DisplayPortAUXDecoderSink* sink )
+{
+	return new DisplayPortAUXDecoder( config, source, sink );
+}
+
+static DisplayPortAUXDecoder* CreateFauxDecoder( const DisplayPortAUXDecoderConfig& config, DisplayPortAUXEdgeSource* source, DisplayPortAUXDecoderSink* sink )
+{
+	return new DisplayPortAUXFauxDecoder( config, source, sink );
+}
+
 void DisplayPortAUXAnalyzer::WorkerThread()
 {
 	mDisplayPortAUX = GetAnalyzerChannelData( mSettings->mInputChannel );
@@ -38,12 +54,29 @@ void DisplayPortAUXAnalyzer::WorkerThread()
 
 	mSampleRateHz = this->GetSampleRate();
 
-	double half_peroid = 1.0 / double( mSettings->mBitRate * 2 );	// Calculate half period in seconds
+	// the detector reads ahead to measure the bit rate, then hands the same edges to the decoder
+	DisplayPortAUXChannelEdgeSource channel_source( this, mDisplayPortAUX );
+	DisplayPortAUXBitRateDetector source( &channel_source );
+	U32 bit_rate = mSettings->mBitRate;
+	bool bit_rate_detected = false;
+	if( mSettings->mDetectBitRate == true )
+	{
+		U32 detected = source.Detect( mSampleRateHz, ( mSettings->mMode == FAUX ) ? 1 : 2 );
+		if( detected != 0 )
+		{
+			bit_rate = detected;
+			bit_rate_detected = true;
+		}
+	}
+	mResults->GetStatistics()->SetDecoderBitRate( bit_rate, bit_rate_detected );
+
+	double half_peroid = 1.0 / double( bit_rate * 2 );	// Calculate half period in seconds
 	half_peroid *= 1000000.0;										// Convert to microseconds
 	mT = U32( ( mSampleRateHz * half_peroid ) / 1000000.0 );		// Convert to sample count
 	switch( mSettings->mTolerance )
 	{
 	case TOL25:
+	case TOLRECOVERED:	// only used to check the STOP symbol
 		mTError = mT / 2;
 		break;
 	case TOL5:
@@ -55,273 +88,42 @@ void DisplayPortAUXAnalyzer::WorkerThread()
 	}
 	if( mTError < 3 )
 		mTError = 3;
-	//mTError = mT / 2;
-	mSynchronized = false;
-
-	mDisplayPortAUX->AdvanceToNextEdge();
-//	mBitsForNextByte.clear();
-//	mUnsyncedLocations.clear();
-//	mIgnoreBitCount = mSettings->mBitsToIgnore;
 
-	U64 packet_num = 0;
-
-	U64 edge_location;
-	U64 next_edge_location;
-	U64 edge_distance;
-
-	Frame frame;
-
-	for( ; ; )
+	// pulses narrower than the line code allows are removed before the decoder classifies the edges
+	DisplayPortAUXDeglitchFilter deglitch( &source, U64( mT ) * mSettings->mDeglitchPercent / 100 );
+	DisplayPortAUXEdgeSource* edges = ( mSettings->mDeglitchPercent != 0 ) ? static_cast< DisplayPortAUXEdgeSource* >( &deglitch ) : &source;
+
+	DisplayPortAUXDecoderConfig config;
+	config.mSampleRateHz = mSampleRateHz;
+	config.mT = mT;
+	config.mTError = mTError;
+	config.mClockRecovery = ( mSettings->mTolerance == TOLRECOVERED );
+	config.mBitRate = bit_rate;
+	config.mSyncBitsNum = mSettings->mSyncBitsNum;
+	config.mInverted = mSettings->mInverted;
+	config.mMarkerDensity = mSettings->mMarkerDensity;
+	config.mCommitFrames = mSettings->mCommitFrames;
+	config.mCommitIntervalMs = mSettings->mCommitIntervalMs;
+	config.mDpcd = mResults->GetDpcdShadow();
+	config.mEdid = mResults->GetEdidReassembler();
+	config.mStatistics = mResults->GetStatistics();
+
+	DisplayPortAUXResultsSink sink( this, mResults.get(), mSettings->mInputChannel, mSettings->mPackDataFrames );
+	// Run() returns only if the source runs out of edges, which never happens with live channel data
+	if( DisplayPortAUXParallelDecoder::GetNumThreads( mSettings->mDecodeThreads ) > 1 )
 	{
-		// Look for valid SYNC sequence
-		U32 sync_count = 0;
-		frame.mStartingSampleInclusive = mDisplayPortAUX->GetSampleNumber();
-		while (mSynchronized == false)
-		{
-			CheckIfThreadShouldExit();
-			edge_location = mDisplayPortAUX->GetSampleNumber();
-			mDisplayPortAUX->AdvanceToNextEdge();
-			next_edge_location = mDisplayPortAUX->GetSampleNumber();
-			edge_distance = next_edge_location - edge_location;
-			if ((edge_distance > (mT - mTError)) && (edge_distance < (mT + mTError))) // short = consecutive equal bits (assuming 0s)
-			{
-				if (sync_count == 0)
-					frame.mStartingSampleInclusive = edge_location;
-				sync_count++;	// counting short periods
-			}
-			else if ((edge_distance > ((5 * mT) - mTError)) && (edge_distance < ((5 * mT) + mTError)) && (sync_count>=(2*mSettings->mSyncBitsNum))) // long = possible START symbol
-			{
-				BitState current_bit_state = mDisplayPortAUX->GetBitState();
-				frame.mEndingSampleInclusive = edge_location + mT;
-				if (current_bit_state == BIT_LOW)
-				{
-					edge_location = mDisplayPortAUX->GetSampleNumber();
-					mDisplayPortAUX->AdvanceToNextEdge();
-					next_edge_location = mDisplayPortAUX->GetSampleNumber();
-					edge_distance = next_edge_location - edge_location;
-					if ((edge_distance > ((5 * mT) - mTError)) && (edge_distance < ((5 * mT) + mTError))) // long = START symbol, next data is 0.
-					{
-						mSynchronized = true;
-						mResults->AddMarker(next_edge_location-mT, AnalyzerResults::Start, mSettings->mInputChannel);
-
-						// report SYNC frame
-						frame.mData1 = sync_count / 2;
-						frame.mData2 = ( mSampleRateHz * sync_count / 2 ) / (frame.mEndingSampleInclusive - frame.mStartingSampleInclusive - mT);
-						frame.mType = AUXSync;
-						frame.mFlags = 0;
-						mResults->AddFrame(frame);
-
-						// report START symbol
-						frame.mStartingSampleInclusive = frame.mEndingSampleInclusive + 1;
-						frame.mEndingSampleInclusive = next_edge_location - mT;
-						frame.mData1 = ++packet_num;
-						frame.mType = AUXStart;
-						frame.mFlags = 0;
-						mResults->AddFrame(frame);
-
-						mResults->CommitResults();
-						ReportProgress(frame.mEndingSampleInclusive);
-					}
-					else if((edge_distance >((4 * mT) - mTError)) && (edge_distance < ((4 * mT) + mTError))) // long = START symbol, next data is 1.
-					{
-						mSynchronized = true;
-						mResults->AddMarker(next_edge_location, AnalyzerResults::Start, mSettings->mInputChannel);
-						
-						// report SYNC frame
-						frame.mData1 = sync_count / 2;
-						frame.mData2 = (mSampleRateHz * sync_count / 2) / (frame.mEndingSampleInclusive - frame.mStartingSampleInclusive - mT);
-						frame.mType = AUXSync;
-						frame.mFlags = 0;
-						mResults->AddFrame(frame);
-
-						// report START symbol
-						frame.mStartingSampleInclusive = frame.mEndingSampleInclusive + 1;
-						frame.mEndingSampleInclusive = next_edge_location;
-						frame.mData1 = ++packet_num;
-						frame.mType = AUXStart;
-						frame.mFlags = 0;
-						mResults->AddFrame(frame);
-
-						mResults->CommitResults();
-						ReportProgress(frame.mEndingSampleInclusive);
-
-						// check and skip 1st half-period of data bit
-						edge_location = mDisplayPortAUX->GetSampleNumber();
-						mDisplayPortAUX->AdvanceToNextEdge();
-						next_edge_location = mDisplayPortAUX->GetSampleNumber();
-						edge_distance = next_edge_location - edge_location;
-						if (!((edge_distance > (mT - mTError)) && (edge_distance < (mT + mTError)))) // if not short, next bit is invalid
-						{
-							mSynchronized = false;
-							mResults->AddMarker(next_edge_location, AnalyzerResults::ErrorDot, mSettings->mInputChannel);
-						}
-					}
-					else
-					{
-						sync_count = 0;	// invalid START
-					}
-				}
-				else
-				{
-					sync_count = 0;	// invalid START
-				}
-
-			}
-			else
-			{
-				sync_count = 0; // long, but not START symbol; reset counter
-			}
-		}
-
-		// Collect data
-		frame.mEndingSampleInclusive = mDisplayPortAUX->GetSampleNumber() - mT;	// preparing frame margin in advance
-		while (mSynchronized == true)
-		{
-			CheckIfThreadShouldExit();
-			// Get data byte
-			U32 value = 0;
-			frame.mStartingSampleInclusive = frame.mEndingSampleInclusive + 1;
-			for (U32 i = 0; i < 8; ++i)	// Collect 8 bit data
-			{
-				// Collecting current bit
-				BitState current_bit_state = mDisplayPortAUX->GetBitState();
-				edge_location = mDisplayPortAUX->GetSampleNumber();
-				value <<= 1;
-				if ((mSettings->mInverted == false) && (current_bit_state == BIT_LOW))	//neg edge, one
-				{
-					value |= 1;
-					mResults->AddMarker(edge_location, AnalyzerResults::One, mSettings->mInputChannel);
-				}
-				else if ((mSettings->mInverted == true) && (current_bit_state == BIT_HIGH))	//pos edge, inverted, one
-				{
-					value |= 1;
-					mResults->AddMarker(edge_location, AnalyzerResults::One, mSettings->mInputChannel);
-				}
-				else
-					mResults->AddMarker(edge_location, AnalyzerResults::Zero, mSettings->mInputChannel);	// another cases represents zero
-
-				if (i < 7)	// need advance for first 7 bits only
-				{
-					mDisplayPortAUX->AdvanceToNextEdge();
-					next_edge_location = mDisplayPortAUX->GetSampleNumber();
-					edge_distance = next_edge_location - edge_location;
-
-					if ((edge_distance > (mT - mTError)) && (edge_distance < (mT + mTError)))	// consecutive equal bits, need advance to next edge
-					{
-						edge_location = mDisplayPortAUX->GetSampleNumber();
-						mDisplayPortAUX->AdvanceToNextEdge();
-						next_edge_location = mDisplayPortAUX->GetSampleNumber();
-						edge_distance = next_edge_location - edge_location;
-						if (!((edge_distance > (mT - mTError)) && (edge_distance < (mT + mTError))))	// wrong interval
-						{
-							mResults->AddMarker(next_edge_location, AnalyzerResults::ErrorDot, mSettings->mInputChannel);	//ErrorDot
-							mSynchronized = false;
-							break;
-						}
-					}
-					else if (!((edge_distance > ((2 * mT) - mTError)) && (edge_distance < ((2 * mT) + mTError))))	// wrong interval
-					{
-						mResults->AddMarker(next_edge_location, AnalyzerResults::ErrorDot, mSettings->mInputChannel);	//ErrorDot
-						mSynchronized = false;
-						break;
-					}
-				}
-			}	// Collect 8 bit data
-			
-			if (mSynchronized == true)	// if valid byte collected
-			{
-				frame.mEndingSampleInclusive = mDisplayPortAUX->GetSampleNumber() + mT;
-
-				frame.mData1 = value;
-				//frame.mData2 = some_more_data_we_collected;
-				frame.mType = AUXData;
-				frame.mFlags = 0;
-
-	/*			if (such_and_such_error == true)
-					frame.mFlags |= SUCH_AND_SUCH_ERROR_FLAG | DISPLAY_AS_ERROR_FLAG;
-				if (such_and_such_warning == true)
-					frame.mFlags |= SUCH_AND_SUCH_WARNING_FLAG | DISPLAY_AS_WARNING_FLAG;
-	*/
-				mResults->AddFrame(frame);
-				mResults->CommitResults();
-				ReportProgress(frame.mEndingSampleInclusive);
-
-				// check for potential STOP symbol
-
-
-				mDisplayPortAUX->AdvanceToNextEdge();
-				next_edge_location = mDisplayPortAUX->GetSampleNumber();
-				edge_distance = next_edge_location - edge_location;
-
-				if ((edge_distance > (mT - mTError)) && (edge_distance < (mT + mTError)))	// consecutive equal bits, need advance to next edge
-				{
-					edge_location = mDisplayPortAUX->GetSampleNumber();
-					mDisplayPortAUX->AdvanceToNextEdge();
-					next_edge_location = mDisplayPortAUX->GetSampleNumber();
-					edge_distance = next_edge_location - edge_location;
-					if (!((edge_distance >(mT - mTError)) && (edge_distance < (mT + mTError))))	// not a data bit interval
-					{
-						if ((edge_distance > ((4 * mT) - mTError)) && (edge_distance < ((4 * mT) + mTError))) // potential STOP. TO DO: Check for bit state
-						{
-							//check here. it might no transition at the end
-							mSynchronized = false;
-							if (!mDisplayPortAUX->WouldAdvancingCauseTransition(4 * mT - mTError))	// check 2nd half of STOP symbol
-							{
-								frame.mStartingSampleInclusive = frame.mEndingSampleInclusive + 1;
-								frame.mEndingSampleInclusive = next_edge_location + 4 * mT;
-								frame.mType = AUXStop;
-								mResults->AddMarker(frame.mStartingSampleInclusive, AnalyzerResults::Stop, mSettings->mInputChannel);
-								mResults->AddFrame(frame);
-
-							}
-							else // STOP error
-							{
-								mResults->AddMarker(next_edge_location, AnalyzerResults::ErrorDot, mSettings->mInputChannel);
-							}
-						}
-						else
-						{
-							mResults->AddMarker(next_edge_location, AnalyzerResults::ErrorDot, mSettings->mInputChannel);	//ErrorDot
-							mSynchronized = false;
-						}
-						
-					}
-				}
-				else if (!((edge_distance >((2 * mT) - mTError)) && (edge_distance < ((2 * mT) + mTError))))	// not a data bit interval
-				{
-					if ((edge_distance >((5 * mT) - mTError)) && (edge_distance < ((5 * mT) + mTError))) // potential STOP. TO DO: Check for bit state
-					{
-						//check here. it might no transition at the end
-						mSynchronized = false;
-						if (!mDisplayPortAUX->WouldAdvancingCauseTransition(4 * mT - mTError))	// check 2nd half of STOP symbol
-						{
-							frame.mStartingSampleInclusive = frame.mEndingSampleInclusive + 1;
-							frame.mEndingSampleInclusive = next_edge_location + 4 * mT;
-							frame.mType = AUXStop;
-							mResults->AddMarker(frame.mStartingSampleInclusive, AnalyzerResults::Stop, mSettings->mInputChannel);
-							mResults->AddFrame(frame);
-
-						}
-						else // STOP error
-						{
-							mResults->AddMarker(next_edge_location, AnalyzerResults::ErrorDot, mSettings->mInputChannel);
-						}
-					}
-					else
-					{
-						mResults->AddMarker(next_edge_location, AnalyzerResults::ErrorDot, mSettings->mInputChannel);	//ErrorDot
-						mSynchronized = false;
-					}
-				}
-
-				mResults->CommitResults();
-				ReportProgress(frame.mEndingSampleInclusive);
-
-			}
-		}
-
-		CheckIfThreadShouldExit();
-
+		DisplayPortAUXParallelDecoder decoder( config, ( mSettings->mMode == FAUX ) ? CreateFauxDecoder : CreateManchesterDecoder, mSettings->mDecodeThreads, edges, &sink );
+		decoder.Run();
+	}
+	else if( mSettings->mMode == FAUX )
+	{
+		DisplayPortAUXFauxDecoder decoder( config, edges, &sink );
+		decoder.Run();
+	}
+	else
+	{
+		DisplayPortAUXDecoder decoder( config, edges, &sink );
+		decoder.Run();
 	}
 }
 
@@ -339,6 +141,10 @@ U32 DisplayPortAUXAnalyzer::GenerateSimulationData( U64 newest_sample_requested,
 
 U32 DisplayPortAUXAnalyzer::GetMinimumSampleRateHz()
 {
+	if( mSettings->mMode == FAUX )
+		return mSettings->mBitRate * 4;	// NRZ, runs are measured in whole bits
+	if( mSettings->mTolerance == TOLRECOVERED )
+		return mSettings->mBitRate * 6;	// 3 samples per half bit, at 2 an edge that is a sample off can change class
 	return mSettings->mBitRate * 8;
 }
 
@@ -13,8 +13,7 @@
 #include "Analyzer.h"
 #include "DisplayPortAUXAnalyzerResults.h"
 #include "DisplayPortAUXSimulationDataGenerator.h"
-
-enum DisplayPortAUXFrameType { AUXSync, AUXStart, AUXData, AUXStop };
+#include "DisplayPortAUXTypes.h"
 
 class DisplayPortAUXAnalyzerSettings;
 
@@ -35,12 +34,6 @@ public:
 #pragma warning( disable : 4251 ) //warning C4251: 'DisplayPortAUXAnalyzer::<...>' : class <...> needs to have dll-interface to be used by clients of class
 protected:
 
-	void ProcessManchesterData();
-	void SynchronizeManchester();
-	void ProcessFaux();
-	void SynchronizeFaux();
-	void SaveBit( U64 location, U32 value );
-	void Invalidate();
 	AnalyzerChannelData* mDisplayPortAUX;
 
 	std::auto_ptr< DisplayPortAUXAnalyzerSettings > mSettings;
@@ -54,10 +47,6 @@ protected:
 
 	U32 mT;
 	U32 mTError;
-	std::vector< std::pair< U64, U64 > > mBitsForNextByte; //value, location
-	std::vector<U64> mUnsyncedLocations;
-	bool mSynchronized;
-	U32 mIgnoreBitCount;
 #pragma warning( pop )
 };
 extern "C" ANALYZER_EXPORT const char* __cdecl GetAnalyzerName( );
@@ -1,10 +1,15 @@
 #include <stdio.h>
+#include <string.h>
 
 #include "DisplayPortAUXAnalyzerResults.h"
 
 #include <AnalyzerHelpers.h>
 #include "DisplayPortAUXAnalyzer.h"
 #include "DisplayPortAUXAnalyzerSettings.h"
+#include "DisplayPortAUXExportWriter.h"
+#include "DisplayPortAUXColumnarWriter.h"
+#include "DisplayPortAUXParallelExport.h"
+#include "DisplayPortAUXPcapng.h"
 #include <iostream>
 #include <sstream>
 
@@ -23,190 +28,755 @@ DisplayPortAUXAnalyzerResults::~DisplayPortAUXAnalyzerResults()
 
 void DisplayPortAUXAnalyzerResults::GenerateBubbleText( U64 frame_index, Channel& /*channel*/, DisplayBase display_base )
 {
-	Frame frame = GetFrame( frame_index );
 	ClearResultStrings();
 
-	char result_str[128];
-	char number_str[128];
-	switch (frame.mType)
+	char text[ DisplayPortAUXRenderCache::MaxTextLength ];
+	U32 length = mRenderCache.Find( frame_index, display_base, DisplayPortAUXRenderCache::BubbleView, text );
+	if( length != 0 )
 	{
-	case AUXSync:
-		AnalyzerHelpers::GetNumberString(frame.mData1, Decimal, mSettings->mBitsPerTransfer, number_str, 128);
-		sprintf(result_str, "%s SYNCs", number_str);
-		AddResultString( "SYNC" );
-		AddResultString(result_str);
-		AnalyzerHelpers::GetNumberString(frame.mData2, Decimal, mSettings->mBitsPerTransfer, number_str, 128);
-		AddResultString(result_str, ", ", number_str, " bps");
-		break;
-	case AUXStart:
-		AnalyzerHelpers::GetNumberString(frame.mData1, Decimal, mSettings->mBitsPerTransfer, number_str, 128);
-		AddResultString( "S" );
-		AddResultString("S #", number_str);
-		AddResultString( "START" );
-		AddResultString("START #", number_str);
-		break;
-	case AUXData:
-		AnalyzerHelpers::GetNumberString(frame.mData1, display_base, mSettings->mBitsPerTransfer, number_str, 128);
-		AddResultString(number_str);
-		break;
-	case AUXStop:
-		AddResultString( "P" );
-		AddResultString( "STOP" );
-		break;
+		AddRenderedText( text, length, DisplayPortAUXRenderCache::BubbleView );
+		return;
 	}
+
+	DisplayPortAUXExportWriter out;
+	FormatBubbleText( out, GetFrame( frame_index ), display_base );
+	mRenderCache.Insert( frame_index, display_base, DisplayPortAUXRenderCache::BubbleView, out.GetBuffer(), out.GetSize() );
+	AddRenderedText( out.GetBuffer(), out.GetSize(), DisplayPortAUXRenderCache::BubbleView );
 }
 
 void DisplayPortAUXAnalyzerResults::GenerateExportFile( const char* file, DisplayBase display_base, U32 export_type_user_id )
 {
-	std::stringstream ss;
-	void* f = AnalyzerHelpers::StartFile( file );
+	DisplayPortAUXExportWriter writer( file );
 
 	U64 trigger_sample = mAnalyzer->GetTriggerSample();
 	U32 sample_rate = mAnalyzer->GetSampleRate();
 	U64 num_frames = GetNumFrames();
-	U32 dump_addr = 0;
+	U64 num_chunks = ( num_frames + ExportChunkFrames - 1 ) / ExportChunkFrames;
+	DisplayPortAUXParallelExport exporter;
+
+	// the frames of a chunk are read on this thread, the workers format copies
+	std::vector< std::vector< Frame > > chunk_frames( exporter.GetNumSlots() );
+	DisplayPortAUXParallelExport::FetchFunction fetch = [ & ]( U64 chunk, U32 slot )
+	{
+		std::vector< Frame >& frames = chunk_frames[ slot ];
+		frames.clear();
+		U64 last = GetChunkEnd( chunk, num_frames );
+		for( U64 i = chunk * ExportChunkFrames; i < last; ++i )
+			frames.push_back( GetFrame( i ) );
+	};
 
 	switch (export_type_user_id)
 	{
 	case DpAuxDMP:
-		
-		char number_str[128];
-
-		for (U32 i = 0; i < num_frames; i++)
 		{
-			Frame frame = GetFrame(i);
-			
-			if (frame.mType == AUXData)
-			{
-				if ((dump_addr % 16) == 0)	// need to add an address
-				{
-					sprintf(number_str, "%08X", dump_addr);
-					ss << number_str << "-> ";
-				}
-				else if ((dump_addr % 4) == 0)	// need to add a space
-					ss << " ";
-
-				// add data
-				sprintf(number_str, "%02X", (U32) frame.mData1);
-				ss << number_str;
-								
-				if ((dump_addr % 16) == 15)  // need to add new line and save
+			// first pass counts the data frames of every chunk, so each chunk knows its starting address
+			std::vector< U64 > chunk_address( size_t( num_chunks + 1 ), 0 );
+			bool completed = exporter.Run( num_chunks, fetch,
+				[ & ]( U64 chunk, U32 slot, DisplayPortAUXExportWriter& /*out*/ )
 				{
-					ss << std::endl;
+					const std::vector< Frame >& frames = chunk_frames[ slot ];
+					U64 count = 0;
+					U8 bytes[ DisplayPortAUXDataBlock::MaxBytes ];
+					for( size_t i = 0; i < frames.size(); ++i )
+						count += GetDataBytes( frames[ i ], bytes );
+					chunk_address[ size_t( chunk + 1 ) ] = count;
+				},
+				writer,
+				[ & ]( U64 chunk ) { return UpdateExportProgressAndCheckForCancel( GetChunkEnd( chunk, num_frames ) / 2, num_frames ); } );
+			if( completed == false )
+				return;
 
-					AnalyzerHelpers::AppendToFile((U8*)ss.str().c_str(), ss.str().length(), f);
-					ss.str(std::string());
-				}
+			for( U64 chunk = 0; chunk < num_chunks; ++chunk )
+				chunk_address[ size_t( chunk + 1 ) ] += chunk_address[ size_t( chunk ) ];
 
-				dump_addr++;
-			}
-			
-			if (UpdateExportProgressAndCheckForCancel(i, num_frames) == true)
-			{
-				AnalyzerHelpers::EndFile(f);
+			completed = exporter.Run( num_chunks, fetch,
+				[ & ]( U64 chunk, U32 slot, DisplayPortAUXExportWriter& out )
+				{
+					const std::vector< Frame >& frames = chunk_frames[ slot ];
+					U64 dump_addr = chunk_address[ size_t( chunk ) ];
+					U8 bytes[ DisplayPortAUXDataBlock::MaxBytes ];
+					for( size_t i = 0; i < frames.size(); ++i )
+					{
+						U32 count = GetDataBytes( frames[ i ], bytes );
+						for( U32 b = 0; b < count; ++b )
+							FormatDumpByte( out, dump_addr++, bytes[ b ] );
+					}
+				},
+				writer,
+				[ & ]( U64 chunk ) { return UpdateExportProgressAndCheckForCancel( ( num_frames + GetChunkEnd( chunk, num_frames ) ) / 2, num_frames ); } );
+			if( completed == false )
 				return;
-			}
 
-		}	// for
+			if( ( chunk_address[ size_t( num_chunks ) ] % 16 ) != 0 )
+				writer.AppendNewLine();
+		}
+		break;
 
-		if (ss.str().length() != 0)
+	case DpAuxTXT:
 		{
-			ss << std::endl;
-			AnalyzerHelpers::AppendToFile((U8*)ss.str().c_str(), ss.str().length(), f);
+			writer.Append( "Time [s]; Data\n" );
+
+			bool completed = exporter.Run( num_chunks, fetch,
+				[ & ]( U64 /*chunk*/, U32 slot, DisplayPortAUXExportWriter& out )
+				{
+					const std::vector< Frame >& frames = chunk_frames[ slot ];
+					for( size_t i = 0; i < frames.size(); ++i )
+						FormatTextFrame( out, frames[ i ], display_base, trigger_sample, sample_rate );
+				},
+				writer,
+				[ & ]( U64 chunk ) { return UpdateExportProgressAndCheckForCancel( GetChunkEnd( chunk, num_frames ), num_frames ); } );
+			if( completed == false )
+				return;
 		}
+		break;
 
+	case DpAuxDPCD:
+		{
+			writer.Append( "Time [s]; Address; Register; Value\n" );
+
+			U64 num_changes = mDpcd.GetNumChanges();
+			for( U64 i = 0; i < num_changes; ++i )
+			{
+				DisplayPortAUXDpcdChange change = mDpcd.GetChange( i );
+
+				writer.AppendTime( change.mSampleNumber, trigger_sample, sample_rate );
+				writer.Append( "; " );
+				writer.AppendNumber( change.mAddress, Hexadecimal, 20 );
+				writer.Append( "; " );
+
+				const char* name = DisplayPortAUXDpcdShadow::GetRegisterName( change.mAddress );
+				if( name != NULL )
+					writer.Append( name );
+				writer.Append( "; " );
+
+				writer.AppendNumber( change.mValue, display_base, 8 );
+				writer.AppendNewLine();
+
+				if( ( ( i % ExportProgressInterval ) == 0 ) && ( UpdateExportProgressAndCheckForCancel( i, num_changes ) == true ) )
+					return;
+			}
+		}
 		break;
 
-	case DpAuxTXT:
-		ss << "Time [s]; Data" << std::endl;
+	case DpAuxEDID:
+		{
+			std::vector< U8 > edid;
+			mEdid.GetEdid( edid );
+			if( edid.empty() == false )
+				writer.Append( &edid[ 0 ], U32( edid.size() ) );
+		}
+		break;
 
-		for (U32 i = 0; i < num_frames; i++)
+	case DpAuxBIN:
 		{
-			Frame frame = GetFrame(i);
+			DisplayPortAUXColumnarWriter columns( &writer, sample_rate, S64( trigger_sample ) );
 
-			//static void GetTimeString( U64 sample, U64 trigger_sample, U32 sample_rate_hz, char* result_string, U32 result_string_max_length );
-			char time_str[128];
-			AnalyzerHelpers::GetTimeString(frame.mStartingSampleInclusive, trigger_sample, sample_rate, time_str, 128);
+			for( U64 i = 0; i < num_frames; ++i )
+			{
+				Frame frame = GetFrame( i );
 
+				DisplayPortAUXFrame aux_frame;
+				aux_frame.mStartingSampleInclusive = frame.mStartingSampleInclusive;
+				aux_frame.mEndingSampleInclusive = frame.mEndingSampleInclusive;
+				aux_frame.mData1 = frame.mData1;
+				aux_frame.mData2 = frame.mData2;
+				aux_frame.mType = frame.mType;
+				aux_frame.mFlags = frame.mFlags;
 
-			ss << time_str << "; ";
+				if( frame.mType == AUXDataBlock )
+				{
+					// the file keeps one frame per byte, whatever the results hold
+					U32 count = DisplayPortAUXDataBlock::GetCount( frame.mFlags );
+					aux_frame.mType = AUXData;
+					aux_frame.mFlags = 0;
+					aux_frame.mData2 = 0;
+					for( U32 b = 0; b < count; ++b )
+					{
+						aux_frame.mStartingSampleInclusive = DisplayPortAUXDataBlock::GetByteStart( frame.mStartingSampleInclusive, frame.mEndingSampleInclusive, count, b );
+						aux_frame.mEndingSampleInclusive = DisplayPortAUXDataBlock::GetByteStart( frame.mStartingSampleInclusive, frame.mEndingSampleInclusive, count, b + 1 ) - 1;
+						aux_frame.mData1 = DisplayPortAUXDataBlock::GetByte( frame.mData1, frame.mData2, b );
+						columns.AddFrame( aux_frame );
+					}
+				}
+				else
+				{
+					columns.AddFrame( aux_frame );
+				}
 
-			char number_str[128];
-			switch (frame.mType)
-			{
-			case AUXSync:
-				AnalyzerHelpers::GetNumberString(frame.mData1, Decimal, mSettings->mBitsPerTransfer, number_str, 128);
-				ss << number_str << " SYNCs, ";
-				AnalyzerHelpers::GetNumberString(frame.mData2, Decimal, mSettings->mBitsPerTransfer, number_str, 128);
-				ss << number_str << " bps";
-				break;
-			case AUXStart:
-				AnalyzerHelpers::GetNumberString(frame.mData1, Decimal, mSettings->mBitsPerTransfer, number_str, 128);
-				ss << "START #" << number_str;
-				break;
-			case AUXData:
-				AnalyzerHelpers::GetNumberString(frame.mData1, display_base, mSettings->mBitsPerTransfer, number_str, 128);
-				ss << number_str;
-				break;
-			case AUXStop:
-				ss << "STOP";
-				break;
+				if( ( ( i % ExportProgressInterval ) == 0 ) && ( UpdateExportProgressAndCheckForCancel( i, num_frames ) == true ) )
+					return;
 			}
 
-			ss << std::endl;
+			columns.Finish();
+		}
+		break;
 
-			AnalyzerHelpers::AppendToFile((U8*)ss.str().c_str(), ss.str().length(), f);
-			ss.str(std::string());
+	case DpAuxPCAPNG:
+		{
+			DisplayPortAUXPcapngWriter pcapng( &writer, sample_rate, S64( trigger_sample ) );
+			U8 bytes[ MaxBurstBytes ];
+			U32 byte_count = 0;
+			S64 burst_start = 0;
+			bool burst_open = false;
 
-			if (UpdateExportProgressAndCheckForCancel(i, num_frames) == true)
+			for( U64 i = 0; i < num_frames; ++i )
 			{
-				AnalyzerHelpers::EndFile(f);
-				return;
+				Frame frame = GetFrame( i );
+
+				switch( frame.mType )
+				{
+				case AUXStart:
+					if( burst_open == true )	// the previous burst never got its STOP
+						pcapng.AddPacket( burst_start, AUXPcapngUnknown, bytes, byte_count, true );
+					burst_start = frame.mStartingSampleInclusive;
+					byte_count = 0;
+					burst_open = true;
+					break;
+				case AUXData:
+				case AUXDataBlock:
+					if( burst_open == true )
+					{
+						U8 data[ DisplayPortAUXDataBlock::MaxBytes ];
+						U32 count = GetDataBytes( frame, data );
+						for( U32 b = 0; ( b < count ) && ( byte_count < MaxBurstBytes ); ++b )
+							bytes[ byte_count++ ] = data[ b ];
+					}
+					break;
+				case AUXStop:
+					if( burst_open == true )
+					{
+						DisplayPortAUXBurst burst;
+						burst.Unpack( frame.mData1, frame.mData2 );
+						DisplayPortAUXPcapngDirection direction = AUXPcapngUnknown;
+						if( burst.mKind == AUXBurstRequest )
+							direction = AUXPcapngSourceToSink;
+						else if( burst.mKind == AUXBurstReply )
+							direction = AUXPcapngSinkToSource;
+
+						pcapng.AddPacket( burst_start, direction, bytes, byte_count, false );
+						burst_open = false;
+					}
+					break;
+				}
+
+				if( ( ( i % ExportProgressInterval ) == 0 ) && ( UpdateExportProgressAndCheckForCancel( i, num_frames ) == true ) )
+					return;
 			}
+
+			if( burst_open == true )
+				pcapng.AddPacket( burst_start, AUXPcapngUnknown, bytes, byte_count, true );
 		}
 		break;
+
+	case DpAuxSTATS:
+		FormatStatistics( writer, mStatistics.GetSummary() );
+		break;
+
+	case DpAuxDEBUG:
+		FormatDecoderCounters( writer, mStatistics.GetSummary().mDecoder );
+		break;
 	}
 	
 	UpdateExportProgressAndCheckForCancel( num_frames, num_frames );
-	AnalyzerHelpers::EndFile( f );
 }
 
-void DisplayPortAUXAnalyzerResults::GenerateFrameTabularText(U64 frame_index, DisplayBase display_base )
+void DisplayPortAUXAnalyzerResults::FormatDumpByte( DisplayPortAUXExportWriter& out, U64 dump_addr, U64 value )
+{
+	if( ( dump_addr % 16 ) == 0 )	// need to add an address
+	{
+		out.AppendHex( dump_addr, 8 );
+		out.Append( "-> " );
+	}
+	else if( ( dump_addr % 4 ) == 0 )	// need to add a space
+		out.AppendChar( ' ' );
+
+	// add data
+	out.AppendHex( value, 2 );
+
+	if( ( dump_addr % 16 ) == 15 )  // need to add new line
+		out.AppendNewLine();
+}
+
+void DisplayPortAUXAnalyzerResults::FormatTextFrame( DisplayPortAUXExportWriter& out, const Frame& frame, DisplayBase display_base, U64 trigger_sample, U32 sample_rate )
+{
+	if( frame.mType == AUXDataBlock )
+	{
+		// one line per byte, as without packing
+		U32 count = DisplayPortAUXDataBlock::GetCount( frame.mFlags );
+		for( U32 b = 0; b < count; ++b )
+		{
+			out.AppendTime( DisplayPortAUXDataBlock::GetByteStart( frame.mStartingSampleInclusive, frame.mEndingSampleInclusive, count, b ), trigger_sample, sample_rate );
+			out.Append( "; " );
+			out.AppendNumber( DisplayPortAUXDataBlock::GetByte( frame.mData1, frame.mData2, b ), display_base, mSettings->mBitsPerTransfer );
+			out.AppendNewLine();
+		}
+		return;
+	}
+
+	out.AppendTime( frame.mStartingSampleInclusive, trigger_sample, sample_rate );
+	out.Append( "; " );
+
+	switch( frame.mType )
+	{
+	case AUXSync:
+		out.AppendNumber( frame.mData1, Decimal, mSettings->mBitsPerTransfer );
+		out.Append( " SYNCs, " );
+		out.AppendNumber( frame.mData2, Decimal, mSettings->mBitsPerTransfer );
+		out.Append( " bps" );
+		break;
+	case AUXStart:
+		out.Append( "START #" );
+		out.AppendNumber( frame.mData1, Decimal, mSettings->mBitsPerTransfer );
+		break;
+	case AUXData:
+		out.AppendNumber( frame.mData1, display_base, mSettings->mBitsPerTransfer );
+		break;
+	case AUXStop:
+		out.Append( "STOP" );
+		break;
+	}
+
+	out.AppendNewLine();
+}
+
+// ns as microseconds with 3 decimals
+static void AppendMicroseconds( DisplayPortAUXExportWriter& out, U64 ns )
+{
+	out.AppendDecimal( ns / 1000 );
+	out.AppendChar( '.' );
+	out.AppendChar( char( '0' + ( ns / 100 ) % 10 ) );
+	out.AppendChar( char( '0' + ( ns / 10 ) % 10 ) );
+	out.AppendChar( char( '0' + ns % 10 ) );
+}
+
+static void AppendReplyCounters( DisplayPortAUXExportWriter& out, const DisplayPortAUXReplyCounters& counters )
+{
+	out.AppendDecimal( counters.mRequests );
+	out.Append( "; " );
+	out.AppendDecimal( counters.mAcks );
+	out.Append( "; " );
+	out.AppendDecimal( counters.mNacks );
+	out.Append( "; " );
+	out.AppendDecimal( counters.mDefers );
+	out.Append( "; " );
+	out.AppendDecimal( counters.mNoReplies );
+	out.AppendNewLine();
+}
+
+static void AppendTimeHistogram( DisplayPortAUXExportWriter& out, const char* title, const DisplayPortAUXHistogram& histogram )
+{
+	out.Append( title );
+	out.Append( "; Count; Min [us]; Mean [us]; Max [us]\n; " );
+	out.AppendDecimal( histogram.mRange.mCount );
+	out.Append( "; " );
+	AppendMicroseconds( out, histogram.mRange.mMin );
+	out.Append( "; " );
+	AppendMicroseconds( out, histogram.mRange.GetMean() );
+	out.Append( "; " );
+	AppendMicroseconds( out, histogram.mRange.mMax );
+	out.Append( "\nFrom [us]; Count\n" );
+
+	for( U32 i = 0; i < histogram.mCounts.size(); ++i )
+	{
+		if( histogram.mCounts[ i ] == 0 )
+			continue;
+		AppendMicroseconds( out, histogram.GetBucketStart( i ) );
+		out.Append( ( i + 1 == histogram.mCounts.size() ) ? "+; " : "; " );
+		out.AppendDecimal( histogram.mCounts[ i ] );
+		out.AppendNewLine();
+	}
+	out.AppendNewLine();
+}
+
+void DisplayPortAUXAnalyzerResults::FormatStatistics( DisplayPortAUXExportWriter& out, const DisplayPortAUXStatisticsSummary& summary )
 {
-    ClearTabularText();
+	out.Append( "Replies; Requests; ACK; NACK; DEFER; No reply\nAll; " );
+	AppendReplyCounters( out, summary.mTotal );
+	for( std::map< U32, DisplayPortAUXReplyCounters >::const_iterator it = summary.mAddressRanges.begin(); it != summary.mAddressRanges.end(); ++it )
+	{
+		if( ( it->first & DisplayPortAUXStatistics::I2CRangeFlag ) != 0 )
+		{
+			out.Append( "I2C 0x" );
+			out.AppendHex( it->first & 0x7F, 2 );
+		}
+		else
+		{
+			out.Append( "DPCD 0x" );
+			out.AppendHex( it->first, 5 );
+			out.Append( "-0x" );
+			out.AppendHex( it->first | 0xFF, 5 );
+		}
+		out.Append( "; " );
+		AppendReplyCounters( out, it->second );
+	}
+	out.AppendNewLine();
+
+	AppendTimeHistogram( out, "Turnaround", summary.mTurnaround );
+	AppendTimeHistogram( out, "Gap between transactions", summary.mGaps );
+
+	out.Append( "DEFER retries; Runs; Storms; Longest\n; " );
+	out.AppendDecimal( summary.mRetryRuns.mRange.mCount );
+	out.Append( "; " );
+	out.AppendDecimal( summary.mRetryStorms );
+	out.Append( "; " );
+	out.AppendDecimal( summary.mRetryRuns.mRange.mMax );
+	out.Append( "\nRetries; Runs\n" );
+	for( U32 i = 1; i < summary.mRetryRuns.mCounts.size(); ++i )
+	{
+		if( summary.mRetryRuns.mCounts[ i ] == 0 )
+			continue;
+		out.AppendDecimal( i );
+		out.Append( ( i + 1 == summary.mRetryRuns.mCounts.size() ) ? "+; " : "; " );
+		out.AppendDecimal( summary.mRetryRuns.mCounts[ i ] );
+		out.AppendNewLine();
+	}
+	out.AppendNewLine();
+
+	out.Append( "Decoder bit rate [bps]; " );
+	out.AppendDecimal( summary.mDecoderBitRate );
+	out.Append( ( summary.mBitRateDetected == true ) ? "; detected\n" : "; setting\n" );
+	out.Append( "SYNC bit rate; Bursts; Min [bps]; Mean [bps]; Max [bps]\n; " );
+	out.AppendDecimal( summary.mBitRate.mCount );
+	out.Append( "; " );
+	out.AppendDecimal( summary.mBitRate.mMin );
+	out.Append( "; " );
+	out.AppendDecimal( summary.mBitRate.GetMean() );
+	out.Append( "; " );
+	out.AppendDecimal( summary.mBitRate.mMax );
+	out.Append( "\nBit rate [bps]; Bursts\n" );
+	for( std::map< U64, U64 >::const_iterator it = summary.mBitRates.begin(); it != summary.mBitRates.end(); ++it )
+	{
+		out.AppendDecimal( it->first );
+		out.Append( "; " );
+		out.AppendDecimal( it->second );
+		out.AppendNewLine();
+	}
+}
+
+static void AppendCounter( DisplayPortAUXExportWriter& out, const char* name, U64 value )
+{
+	out.Append( name );
+	out.Append( "; " );
+	out.AppendDecimal( value );
+	out.AppendNewLine();
+}
+
+void DisplayPortAUXAnalyzerResults::FormatDecoderCounters( DisplayPortAUXExportWriter& out, const DisplayPortAUXDecoderCounters& counters )
+{
+	out.Append( "Decoder; Value\n" );
+	AppendCounter( out, "Edges", counters.mEdges );
+	AppendCounter( out, "Bytes", counters.mBytes );
+	AppendCounter( out, "Bursts with STOP", counters.mBursts );
+	AppendCounter( out, "Sync acquired", counters.mSyncAcquired );
+	AppendCounter( out, "Sync lost", counters.mSyncLost );
+	AppendCounter( out, "Glitches filtered", counters.mGlitches );
+	AppendCounter( out, "Edges skipped after errors", counters.mSkippedEdges );
+
+	out.Append( "Decode time [us]; " );
+	AppendMicroseconds( out, counters.mDecodeNs );
+	out.Append( "\nWait for edges [us]; " );
+	AppendMicroseconds( out, counters.mSourceNs );
+	out.Append( "\nDecode time per edge [ns]; " );
+	AppendMicroseconds( out, ( counters.mEdges != 0 ) ? counters.mDecodeNs * 1000 / counters.mEdges : 0 );	// 3 decimals
+	out.Append( "\n\nError; Count\n" );
+
+	for( U32 i = 0; i < AUXErrorCount; ++i )
+		AppendCounter( out, DisplayPortAUXDecoderCounters::GetErrorName( i ), counters.mErrors[ i ] );
+}
+
+void DisplayPortAUXAnalyzerResults::GenerateFrameTabularText( U64 frame_index, DisplayBase display_base )
+{
+	ClearTabularText();
+
+	char text[ DisplayPortAUXRenderCache::MaxTextLength ];
+	U32 length = mRenderCache.Find( frame_index, display_base, DisplayPortAUXRenderCache::TabularView, text );
+	if( length != 0 )
+	{
+		AddRenderedText( text, length, DisplayPortAUXRenderCache::TabularView );
+		return;
+	}
+
+	DisplayPortAUXExportWriter out;
+	FormatFrameTabularText( out, GetFrame( frame_index ), display_base );
+	mRenderCache.Insert( frame_index, display_base, DisplayPortAUXRenderCache::TabularView, out.GetBuffer(), out.GetSize() );
+	AddRenderedText( out.GetBuffer(), out.GetSize(), DisplayPortAUXRenderCache::TabularView );
+}
+
+void DisplayPortAUXAnalyzerResults::GeneratePacketTabularText( U64 packet_id, DisplayBase display_base )
+{
+	ClearTabularText();
 
-	Frame frame = GetFrame(frame_index);
+	DisplayPortAUXBurst burst;
+	if( GetPacketBurst( packet_id, burst ) == false )
+	{
+		AddTabularText( "Incomplete burst" );
+		return;
+	}
+
+	char result_str[128];
+	GetBurstString( burst, display_base, result_str, 128 );
+	AddTabularText( result_str );
+}
+
+void DisplayPortAUXAnalyzerResults::GenerateTransactionTabularText( U64 transaction_id, DisplayBase display_base )
+{
+	ClearTabularText();
+
+	U64* packet_ids;
+	U64 packet_count;
+	GetPacketsContainedInTransaction( transaction_id, &packet_ids, &packet_count );
+
+	// a transaction is a request followed by at most one reply
+	DisplayPortAUXBurst request;
+	DisplayPortAUXBurst reply;
+	U64 reply_end = 0;
+	bool have_request = false;
+	bool have_reply = false;
+	for( U64 i = 0; i < packet_count; ++i )
+	{
+		DisplayPortAUXBurst burst;
+		U64 end_sample;
+		if( GetPacketBurst( packet_ids[ i ], burst, &end_sample ) == false )
+			continue;
+		if( burst.mKind == AUXBurstRequest )
+		{
+			request = burst;
+			have_request = true;
+		}
+		else if( burst.mKind == AUXBurstReply )
+		{
+			reply = burst;
+			reply_end = end_sample;
+			have_reply = true;
+		}
+	}
+
+	if( have_request == false )
+		return;
 
 	char result_str[128];
 	char number_str[128];
-	switch (frame.mType)
+	GetBurstString( request, display_base, result_str, 128 );
+	if( have_reply == false )
+	{
+		AddTabularText( result_str, ": no reply" );
+	}
+	else if( ( request.IsNative() == true ) && ( reply.GetNativeReply() == AUXReplyAck ) && ( request.mLength != 0 ) )
+	{
+		// register contents right after the access, from the DPCD shadow
+		std::stringstream ss;
+		U32 count = ( request.mLength < 4 ) ? request.mLength : 4;
+		for( U32 i = 0; i < count; ++i )
+		{
+			U8 value;
+			if( mDpcd.GetValueAt( request.mAddress + i, reply_end, value ) == false )
+				break;
+			AnalyzerHelpers::GetNumberString( value, display_base, 8, number_str, 128 );
+			ss << ( ( i == 0 ) ? " = " : " " ) << number_str;
+		}
+		if( count < request.mLength )
+			ss << " ...";
+		AddTabularText( result_str, ": ", reply.GetReplyName(), ss.str().c_str() );
+	}
+	else
+	{
+		char reply_str[128];
+		GetBurstString( reply, display_base, reply_str, 128 );
+		AddTabularText( result_str, ": ", reply_str + 6 );	// without "Reply "
+	}
+}
+
+U32 DisplayPortAUXAnalyzerResults::GetDataBytes( const Frame& frame, U8* bytes )
+{
+	if( frame.mType == AUXData )
+	{
+		bytes[ 0 ] = U8( frame.mData1 );
+		return 1;
+	}
+	if( frame.mType != AUXDataBlock )
+		return 0;
+
+	U32 count = DisplayPortAUXDataBlock::GetCount( frame.mFlags );
+	for( U32 i = 0; i < count; ++i )
+		bytes[ i ] = DisplayPortAUXDataBlock::GetByte( frame.mData1, frame.mData2, i );
+	return count;
+}
+
+// every string ends with a zero, the strings are added in order
+void DisplayPortAUXAnalyzerResults::FormatBubbleText( DisplayPortAUXExportWriter& out, const Frame& frame, DisplayBase display_base )
+{
+	switch( frame.mType )
+	{
+	case AUXSync:
+		out.Append( "SYNC" );
+		out.AppendChar( 0 );
+		out.AppendNumber( frame.mData1, Decimal, mSettings->mBitsPerTransfer );
+		out.Append( " SYNCs" );
+		out.AppendChar( 0 );
+		out.AppendNumber( frame.mData1, Decimal, mSettings->mBitsPerTransfer );
+		out.Append( " SYNCs, " );
+		out.AppendNumber( frame.mData2, Decimal, mSettings->mBitsPerTransfer );
+		out.Append( " bps" );
+		out.AppendChar( 0 );
+		break;
+	case AUXStart:
+		out.Append( "S" );
+		out.AppendChar( 0 );
+		out.Append( "S #" );
+		out.AppendNumber( frame.mData1, Decimal, mSettings->mBitsPerTransfer );
+		out.AppendChar( 0 );
+		out.Append( "START" );
+		out.AppendChar( 0 );
+		out.Append( "START #" );
+		out.AppendNumber( frame.mData1, Decimal, mSettings->mBitsPerTransfer );
+		out.AppendChar( 0 );
+		break;
+	case AUXData:
+		out.AppendNumber( frame.mData1, display_base, mSettings->mBitsPerTransfer );
+		out.AppendChar( 0 );
+		break;
+	case AUXDataBlock:
+		out.AppendDecimal( DisplayPortAUXDataBlock::GetCount( frame.mFlags ) );
+		out.Append( " bytes" );
+		out.AppendChar( 0 );
+		FormatDataBlock( out, frame, display_base );
+		out.AppendChar( 0 );
+		break;
+	case AUXStop:
+		out.Append( "P" );
+		out.AppendChar( 0 );
+		out.Append( "STOP" );
+		out.AppendChar( 0 );
+		out.Append( "STOP, " );
+		FormatStopBurst( out, frame, display_base );
+		out.AppendChar( 0 );
+		break;
+	}
+}
+
+void DisplayPortAUXAnalyzerResults::FormatFrameTabularText( DisplayPortAUXExportWriter& out, const Frame& frame, DisplayBase display_base )
+{
+	switch( frame.mType )
 	{
 	case AUXSync:
-		AnalyzerHelpers::GetNumberString(frame.mData1, Decimal, mSettings->mBitsPerTransfer, number_str, 128);
-		sprintf(result_str, "%s SYNCs", number_str);
-		AnalyzerHelpers::GetNumberString(frame.mData2, Decimal, mSettings->mBitsPerTransfer, number_str, 128);
-		AddTabularText(result_str, ", ", number_str, " bps");
+		out.AppendNumber( frame.mData1, Decimal, mSettings->mBitsPerTransfer );
+		out.Append( " SYNCs, " );
+		out.AppendNumber( frame.mData2, Decimal, mSettings->mBitsPerTransfer );
+		out.Append( " bps" );
 		break;
 	case AUXStart:
-		AnalyzerHelpers::GetNumberString(frame.mData1, Decimal, mSettings->mBitsPerTransfer, number_str, 128);
-		AddTabularText("START #", number_str);
+		out.Append( "START #" );
+		out.AppendNumber( frame.mData1, Decimal, mSettings->mBitsPerTransfer );
 		break;
 	case AUXData:
-		AnalyzerHelpers::GetNumberString(frame.mData1, display_base, mSettings->mBitsPerTransfer, number_str, 128);
-		AddTabularText(number_str);
+		out.AppendNumber( frame.mData1, display_base, mSettings->mBitsPerTransfer );
+		break;
+	case AUXDataBlock:
+		FormatDataBlock( out, frame, display_base );
 		break;
 	case AUXStop:
-		AddTabularText("STOP");
+		out.Append( "STOP, " );
+		FormatStopBurst( out, frame, display_base );
 		break;
+	default:
+		return;
+	}
+	out.AppendChar( 0 );
+}
+
+void DisplayPortAUXAnalyzerResults::FormatDataBlock( DisplayPortAUXExportWriter& out, const Frame& frame, DisplayBase display_base )
+{
+	U32 count = DisplayPortAUXDataBlock::GetCount( frame.mFlags );
+	for( U32 i = 0; i < count; ++i )
+	{
+		if( i != 0 )
+			out.AppendChar( ' ' );
+		out.AppendNumber( DisplayPortAUXDataBlock::GetByte( frame.mData1, frame.mData2, i ), display_base, mSettings->mBitsPerTransfer );
 	}
 }
 
-void DisplayPortAUXAnalyzerResults::GeneratePacketTabularText( U64 /*packet_id*/, DisplayBase /*display_base*/ )
+void DisplayPortAUXAnalyzerResults::FormatStopBurst( DisplayPortAUXExportWriter& out, const Frame& frame, DisplayBase display_base )
 {
+	DisplayPortAUXBurst burst;
+	burst.Unpack( frame.mData1, frame.mData2 );
 
+	char result_str[128];
+	GetBurstString( burst, display_base, result_str, 128 );
+	out.Append( result_str );
 }
 
-void DisplayPortAUXAnalyzerResults::GenerateTransactionTabularText( U64 /*transaction_id*/, DisplayBase /*display_base*/ )
+void DisplayPortAUXAnalyzerResults::AddRenderedText( const char* text, U32 length, DisplayPortAUXRenderCache::View view )
 {
+	for( U32 pos = 0; pos < length; pos += U32( strlen( text + pos ) ) + 1 )
+	{
+		if( view == DisplayPortAUXRenderCache::BubbleView )
+			AddResultString( text + pos );
+		else
+			AddTabularText( text + pos );
+	}
+}
+
+bool DisplayPortAUXAnalyzerResults::GetPacketBurst( U64 packet_id, DisplayPortAUXBurst& burst, U64* end_sample )
+{
+	U64 first_frame_id;
+	U64 last_frame_id;
+	GetFramesContainedInPacket( packet_id, &first_frame_id, &last_frame_id );
+
+	Frame frame = GetFrame( last_frame_id );	// the summary is in the STOP frame
+	if( frame.mType != AUXStop )
+		return false;
+
+	burst.Unpack( frame.mData1, frame.mData2 );
+	if( end_sample != NULL )
+		*end_sample = frame.mEndingSampleInclusive;
+	return burst.mKind != AUXBurstIncomplete;
+}
 
+void DisplayPortAUXAnalyzerResults::GetBurstString( const DisplayPortAUXBurst& burst, DisplayBase display_base, char* result_string, U32 result_string_max_length )
+{
+	char address_str[64];
+	char number_str[64];
+	switch( burst.mKind )
+	{
+	case AUXBurstRequest:
+		AnalyzerHelpers::GetNumberString( burst.mAddress, display_base, 20, address_str, 64 );
+		if( ( burst.IsNative() == true ) && ( DisplayPortAUXDpcdShadow::GetRegisterName( burst.mAddress ) != NULL ) )
+		{
+			strncat( address_str, " ", 63 - strlen( address_str ) );
+			strncat( address_str, DisplayPortAUXDpcdShadow::GetRegisterName( burst.mAddress ), 63 - strlen( address_str ) );
+		}
+		if( burst.mLength == 0 )
+		{
+			snprintf( result_string, result_string_max_length, "%s %s, address only", burst.GetCommandName(), address_str );
+		}
+		else
+		{
+			AnalyzerHelpers::GetNumberString( burst.mLength, Decimal, 16, number_str, 64 );
+			snprintf( result_string, result_string_max_length, "%s %s, %s bytes", burst.GetCommandName(), address_str, number_str );
+		}
+		break;
+	case AUXBurstReply:
+		if( burst.mDataCount == 0 )
+		{
+			snprintf( result_string, result_string_max_length, "Reply %s", burst.GetReplyName() );
+		}
+		else
+		{
+			AnalyzerHelpers::GetNumberString( burst.mDataCount, Decimal, 8, number_str, 64 );
+			snprintf( result_string, result_string_max_length, "Reply %s, %s bytes", burst.GetReplyName(), number_str );
+		}
+		if( burst.mEdidStatus != AUXEdidNone )
+		{
+			U32 length = U32( strlen( result_string ) );
+			snprintf( result_string + length, result_string_max_length - length, ", EDID block %u %s", burst.mEdidBlock,
+				( burst.mEdidStatus == AUXEdidBlockOk ) ? "OK" : "checksum error" );
+		}
+		break;
+	case AUXBurstInvalid:
+		snprintf( result_string, result_string_max_length, "Invalid burst" );
+		break;
+	default:
+		snprintf( result_string, result_string_max_length, "Incomplete burst" );
+		break;
+	}
 }
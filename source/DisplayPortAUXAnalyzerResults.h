@@ -2,8 +2,14 @@
 #define DISPLAYPORTAUX_ANALYZER_RESULTS
 
 #include <AnalyzerResults.h>
+#include "DisplayPortAUXTransaction.h"
+#include "DisplayPortAUXDpcd.h"
+#include "DisplayPortAUXEdid.h"
+#include "DisplayPortAUXStatistics.h"
+#include "DisplayPortAUXRenderCache.h"
 
 class DisplayPortAUXAnalyzer;
+class DisplayPortAUXExportWriter;
 class DisplayPortAUXAnalyzerSettings;
 
 class DisplayPortAUXAnalyzerResults : public AnalyzerResults
@@ -19,11 +25,39 @@ public:
 	virtual void GeneratePacketTabularText( U64 packet_id, DisplayBase display_base );
 	virtual void GenerateTransactionTabularText( U64 transaction_id, DisplayBase display_base );
 
+	DisplayPortAUXDpcdShadow* GetDpcdShadow() { return &mDpcd; }
+	DisplayPortAUXEdidReassembler* GetEdidReassembler() { return &mEdid; }
+	DisplayPortAUXStatistics* GetStatistics() { return &mStatistics; }
+	DisplayPortAUXRenderCache* GetRenderCache() { return &mRenderCache; }
+
 protected: //functions
+	enum { ExportProgressInterval = 4096 };	// frames between export progress updates
+	enum { ExportChunkFrames = 16384 };	// frames formatted by one worker of the parallel export
+	enum { MaxBurstBytes = 64 };	// longest burst in the pcapng export, longer ones are cut
+
+	static U64 GetChunkEnd( U64 chunk, U64 num_frames ) { return ( ( chunk + 1 ) * ExportChunkFrames < num_frames ) ? ( chunk + 1 ) * ExportChunkFrames : num_frames; }
+	void FormatDumpByte( DisplayPortAUXExportWriter& out, U64 dump_addr, U64 value );
+	void FormatTextFrame( DisplayPortAUXExportWriter& out, const Frame& frame, DisplayBase display_base, U64 trigger_sample, U32 sample_rate );
+	void FormatStatistics( DisplayPortAUXExportWriter& out, const DisplayPortAUXStatisticsSummary& summary );
+	void FormatDecoderCounters( DisplayPortAUXExportWriter& out, const DisplayPortAUXDecoderCounters& counters );
+
+	static U32 GetDataBytes( const Frame& frame, U8* bytes );	// AUXData and AUXDataBlock frames, 0 for the others
+	void FormatBubbleText( DisplayPortAUXExportWriter& out, const Frame& frame, DisplayBase display_base );
+	void FormatFrameTabularText( DisplayPortAUXExportWriter& out, const Frame& frame, DisplayBase display_base );
+	void FormatDataBlock( DisplayPortAUXExportWriter& out, const Frame& frame, DisplayBase display_base );
+	void FormatStopBurst( DisplayPortAUXExportWriter& out, const Frame& frame, DisplayBase display_base );
+	void AddRenderedText( const char* text, U32 length, DisplayPortAUXRenderCache::View view );
+
+	bool GetPacketBurst( U64 packet_id, DisplayPortAUXBurst& burst, U64* end_sample = NULL );
+	void GetBurstString( const DisplayPortAUXBurst& burst, DisplayBase display_base, char* result_string, U32 result_string_max_length );
 
 protected:  //vars
 	DisplayPortAUXAnalyzerSettings* mSettings;
 	DisplayPortAUXAnalyzer* mAnalyzer;
+	DisplayPortAUXDpcdShadow mDpcd;	// filled by the decoder
+	DisplayPortAUXEdidReassembler mEdid;	// filled by the decoder
+	DisplayPortAUXStatistics mStatistics;	// filled by the decoder
+	DisplayPortAUXRenderCache mRenderCache;	// bubble and tabular text of recently drawn frames
 };
 
 
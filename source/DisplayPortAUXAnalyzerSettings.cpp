@@ -11,11 +11,21 @@ DisplayPortAUXAnalyzerSettings::DisplayPortAUXAnalyzerSettings()
 :	mInputChannel( UNDEFINED_CHANNEL ),
 	mMode( Manchester ),
 	mBitRate( 1000000 ),
+	mDetectBitRate( false ),
 	mInverted( false ),
 	mBitsPerTransfer( 8 ),
 	mShiftOrder( AnalyzerEnums::MsbFirst ),
 	mSyncBitsNum( 16 ),
 	mTolerance( TOL25 ),
+	mDeglitchPercent( 0 ),
+	mMarkerDensity( MarkersAllBits ),
+	mPackDataFrames( false ),
+	mCommitFrames( 256 ),
+	mCommitIntervalMs( 50 ),
+	mDecodeThreads( 1 ),
+	mSimScenario( ScenarioCounter ),
+	mSimJitterPercent( 0 ),
+	mSimGlitchRate( 0 ),
 	mAbout( 0 )
 {
 	mInputChannelInterface.reset( new AnalyzerSettingInterfaceChannel() );
@@ -25,7 +35,7 @@ DisplayPortAUXAnalyzerSettings::DisplayPortAUXAnalyzerSettings()
 	mModeInterface.reset( new AnalyzerSettingInterfaceNumberList() );
 	mModeInterface->SetTitleAndTooltip( "Mode", "Specify the Display Port AUX Mode" );
 	mModeInterface->AddNumber( Manchester, "Manchester", "" );
-	mModeInterface->AddNumber( FAUX, "Fast AUX (not supported)", "" );
+	mModeInterface->AddNumber( FAUX, "Fast AUX (8b/10b)", "NRZ, 8b/10b coded, K28.5 preamble, K27.7 START, K29.7 STOP" );
 	mModeInterface->SetNumber( mMode );
 
 	mBitRateInterface.reset( new AnalyzerSettingInterfaceInteger() );
@@ -34,6 +44,12 @@ DisplayPortAUXAnalyzerSettings::DisplayPortAUXAnalyzerSettings()
 	mBitRateInterface->SetMin( 1 );
 	mBitRateInterface->SetInteger( mBitRate );
 
+	mDetectBitRateInterface.reset( new AnalyzerSettingInterfaceNumberList() );
+	mDetectBitRateInterface->SetTitleAndTooltip( "Bit rate detection", "Measure the bit rate from the first edges of the capture before decoding" );
+	mDetectBitRateInterface->AddNumber( false, "Use the bit rate above", "" );
+	mDetectBitRateInterface->AddNumber( true, "Detect from the first edges", "The bit rate above is used if the first edges show no clear bit rate" );
+	mDetectBitRateInterface->SetNumber( mDetectBitRate );
+
 	mInvertedInterface.reset( new AnalyzerSettingInterfaceNumberList() );
 	mInvertedInterface->SetTitleAndTooltip( "", "Specify the DisplayPortAUX edge polarity (Normal DisplayPortAUX mode only)" );
 	mInvertedInterface->AddNumber( false, "negative edge is binary one", "" );
@@ -61,8 +77,68 @@ DisplayPortAUXAnalyzerSettings::DisplayPortAUXAnalyzerSettings()
 	mToleranceInterface->AddNumber( TOL25, "25% of period (default)", "Maximum allowed tolerance, +- 50% of one half period" );
 	mToleranceInterface->AddNumber( TOL5, "5% of period", "Required more than 10x over sampling" );
 	mToleranceInterface->AddNumber( TOL05, "0.5% of period", "Requires more than 200x over sampling" );
+	mToleranceInterface->AddNumber( TOLRECOVERED, "Recover clock from SYNC", "Measures the bit rate of every SYNC and follows it through the burst; works down to 6x over sampling (Manchester only)" );
 	mToleranceInterface->SetNumber( mTolerance );
 
+	mDeglitchPercentInterface.reset( new AnalyzerSettingInterfaceInteger() );
+	mDeglitchPercentInterface->SetTitleAndTooltip( "Deglitch filter (% of half bit)", "Remove pulses narrower than this before decoding, e.g. 50 on noisy cables; 0 turns the filter off" );
+	mDeglitchPercentInterface->SetMax( 75 );
+	mDeglitchPercentInterface->SetMin( 0 );
+	mDeglitchPercentInterface->SetInteger( mDeglitchPercent );
+
+	mMarkerDensityInterface.reset( new AnalyzerSettingInterfaceNumberList() );
+	mMarkerDensityInterface->SetTitleAndTooltip( "Markers", "Specify which markers are placed on the waveform" );
+	mMarkerDensityInterface->AddNumber( MarkersAllBits, "Every bit, START, STOP and errors (default)", "One/Zero marker on every decoded bit" );
+	mMarkerDensityInterface->AddNumber( MarkersStartStopErrors, "START, STOP and errors only", "No per bit markers, much smaller results on long captures" );
+	mMarkerDensityInterface->AddNumber( MarkersNone, "None", "No markers at all" );
+	mMarkerDensityInterface->SetNumber( mMarkerDensity );
+
+	mPackDataFramesInterface.reset( new AnalyzerSettingInterfaceNumberList() );
+	mPackDataFramesInterface->SetTitleAndTooltip( "Data frames", "Specify how the data bytes of a burst are put into result frames" );
+	mPackDataFramesInterface->AddNumber( false, "One frame per byte (default)", "" );
+	mPackDataFramesInterface->AddNumber( true, "Up to 16 bytes per frame", "Up to 16x fewer frames, much smaller results on long captures" );
+	mPackDataFramesInterface->SetNumber( mPackDataFrames );
+
+	mCommitFramesInterface.reset( new AnalyzerSettingInterfaceInteger() );
+	mCommitFramesInterface->SetTitleAndTooltip( "Commit every N frames", "Publish decoded results to the display after this many frames (a finished burst is always published)" );
+	mCommitFramesInterface->SetMax( 1000000 );
+	mCommitFramesInterface->SetMin( 1 );
+	mCommitFramesInterface->SetInteger( mCommitFrames );
+
+	mCommitIntervalMsInterface.reset( new AnalyzerSettingInterfaceInteger() );
+	mCommitIntervalMsInterface->SetTitleAndTooltip( "Commit interval (ms)", "Publish decoded results to the display at least this often" );
+	mCommitIntervalMsInterface->SetMax( 10000 );
+	mCommitIntervalMsInterface->SetMin( 1 );
+	mCommitIntervalMsInterface->SetInteger( mCommitIntervalMs );
+
+	mDecodeThreadsInterface.reset( new AnalyzerSettingInterfaceInteger() );
+	mDecodeThreadsInterface->SetTitleAndTooltip( "Decoder threads", "Decode pieces of the capture between idle gaps on this many threads, at most one per core; 1 decodes in one pass, as does a single core, 0 uses one thread per core" );
+	mDecodeThreadsInterface->SetMax( 64 );
+	mDecodeThreadsInterface->SetMin( 0 );
+	mDecodeThreadsInterface->SetInteger( mDecodeThreads );
+
+	mSimScenarioInterface.reset( new AnalyzerSettingInterfaceNumberList() );
+	mSimScenarioInterface->SetTitleAndTooltip( "Simulation traffic", "Specify what the simulation sends" );
+	mSimScenarioInterface->AddNumber( ScenarioCounter, "Counter bursts (default)", "Bursts of 4 counting bytes" );
+	mSimScenarioInterface->AddNumber( ScenarioMixed, "Mixed AUX traffic", "All of the scenarios below at random" );
+	mSimScenarioInterface->AddNumber( ScenarioNativeAux, "Native AUX reads and writes", "DPCD reads and writes with their replies" );
+	mSimScenarioInterface->AddNumber( ScenarioDeferStorm, "DEFER storms", "Requests deferred several times before they are acknowledged" );
+	mSimScenarioInterface->AddNumber( ScenarioEdidRead, "EDID reads", "I2C-over-AUX reads of a two block EDID" );
+	mSimScenarioInterface->AddNumber( ScenarioLinkTraining, "Link training", "Clock recovery and channel equalization with lane status polling" );
+	mSimScenarioInterface->SetNumber( mSimScenario );
+
+	mSimJitterPercentInterface.reset( new AnalyzerSettingInterfaceInteger() );
+	mSimJitterPercentInterface->SetTitleAndTooltip( "Simulation jitter (% of half bit)", "Move every simulated edge by up to this much either way" );
+	mSimJitterPercentInterface->SetMax( 40 );
+	mSimJitterPercentInterface->SetMin( 0 );
+	mSimJitterPercentInterface->SetInteger( mSimJitterPercent );
+
+	mSimGlitchRateInterface.reset( new AnalyzerSettingInterfaceInteger() );
+	mSimGlitchRateInterface->SetTitleAndTooltip( "Simulation glitches per 10000 runs", "Put a short pulse into this many of every 10000 simulated runs between edges" );
+	mSimGlitchRateInterface->SetMax( 10000 );
+	mSimGlitchRateInterface->SetMin( 0 );
+	mSimGlitchRateInterface->SetInteger( mSimGlitchRate );
+
 	mAboutInterface.reset(new AnalyzerSettingInterfaceNumberList());
 	mAboutInterface->SetTitleAndTooltip("About Ananlyzer", "Here is some info about this analyzer");
 	mAboutInterface->AddNumber(0, "DP AUX Analyzer v1.1 '2018", "Display Port AUX Analyzer ver. 1.1 '2018");
@@ -75,11 +151,21 @@ DisplayPortAUXAnalyzerSettings::DisplayPortAUXAnalyzerSettings()
 	AddInterface( mInputChannelInterface.get() );
 	AddInterface( mModeInterface.get() );
 	AddInterface( mBitRateInterface.get() );
+	AddInterface( mDetectBitRateInterface.get() );
 	AddInterface( mInvertedInterface.get() );
 	AddInterface( mBitsPerTransferInterface.get() );
 	AddInterface( mShiftOrderInterface.get() );
 	AddInterface( mSyncBitsNumInterface.get() );
 	AddInterface( mToleranceInterface.get() );
+	AddInterface( mDeglitchPercentInterface.get() );
+	AddInterface( mMarkerDensityInterface.get() );
+	AddInterface( mPackDataFramesInterface.get() );
+	AddInterface( mCommitFramesInterface.get() );
+	AddInterface( mCommitIntervalMsInterface.get() );
+	AddInterface( mDecodeThreadsInterface.get() );
+	AddInterface( mSimScenarioInterface.get() );
+	AddInterface( mSimJitterPercentInterface.get() );
+	AddInterface( mSimGlitchRateInterface.get() );
 	AddInterface( mAboutInterface.get() );
 
 	AddExportOption(DpAuxDMP, "Export as HEX dump");
@@ -90,6 +176,26 @@ DisplayPortAUXAnalyzerSettings::DisplayPortAUXAnalyzerSettings()
 	AddExportExtension( DpAuxTXT, "text", "txt" );
 	AddExportExtension( DpAuxTXT, "csv", "csv" );
 
+	AddExportOption( DpAuxDPCD, "Export DPCD register changes" );
+	AddExportExtension( DpAuxDPCD, "text", "txt" );
+	AddExportExtension( DpAuxDPCD, "csv", "csv" );
+
+	AddExportOption( DpAuxEDID, "Export EDID (binary)" );
+	AddExportExtension( DpAuxEDID, "EDID", "bin" );
+
+	AddExportOption( DpAuxBIN, "Export frames as binary columns" );
+	AddExportExtension( DpAuxBIN, "DisplayPort AUX frames", "dpaux" );
+
+	AddExportOption( DpAuxPCAPNG, "Export bursts as pcapng" );
+	AddExportExtension( DpAuxPCAPNG, "pcapng", "pcapng" );
+
+	AddExportOption( DpAuxSTATS, "Export timing and reply statistics" );
+	AddExportExtension( DpAuxSTATS, "text", "txt" );
+	AddExportExtension( DpAuxSTATS, "csv", "csv" );
+
+	AddExportOption( DpAuxDEBUG, "Export decoder diagnostics" );
+	AddExportExtension( DpAuxDEBUG, "text", "txt" );
+
 	ClearChannels();
 	AddChannel( mInputChannel, "Display Port AUX", false );
 }
@@ -104,11 +210,21 @@ bool DisplayPortAUXAnalyzerSettings::SetSettingsFromInterfaces()
 	mInputChannel = mInputChannelInterface->GetChannel();
 	mMode = DisplayPortAUXMode( U32( mModeInterface->GetNumber() ) );
 	mBitRate = mBitRateInterface->GetInteger();
+	mDetectBitRate = bool( U32( mDetectBitRateInterface->GetNumber() ) );
 	mInverted = bool( U32( mInvertedInterface->GetNumber() ) );
 	mBitsPerTransfer = U32( mBitsPerTransferInterface->GetNumber() );
 	mShiftOrder =  AnalyzerEnums::ShiftOrder( U32( mShiftOrderInterface->GetNumber() ) );
 	mSyncBitsNum = mSyncBitsNumInterface->GetInteger();
 	mTolerance = DisplayPortAUXTolerance( U32( mToleranceInterface->GetNumber() ) );
+	mDeglitchPercent = mDeglitchPercentInterface->GetInteger();
+	mMarkerDensity = DisplayPortAUXMarkerDensity( U32( mMarkerDensityInterface->GetNumber() ) );
+	mPackDataFrames = bool( U32( mPackDataFramesInterface->GetNumber() ) );
+	mCommitFrames = mCommitFramesInterface->GetInteger();
+	mCommitIntervalMs = mCommitIntervalMsInterface->GetInteger();
+	mDecodeThreads = mDecodeThreadsInterface->GetInteger();
+	mSimScenario = DisplayPortAUXScenarioType( U32( mSimScenarioInterface->GetNumber() ) );
+	mSimJitterPercent = mSimJitterPercentInterface->GetInteger();
+	mSimGlitchRate = mSimGlitchRateInterface->GetInteger();
 	mAbout = U32( mAboutInterface->GetNumber() );
 	ClearChannels();
 	AddChannel( mInputChannel, "Display Port AUX", true );
@@ -126,19 +242,63 @@ void DisplayPortAUXAnalyzerSettings::LoadSettings( const char* settings )
 		AnalyzerHelpers::Assert( "SaleaeDisplayPortAUXAnalyzer: Provided with a settings string that doesn't belong to us;" );
 
 	text_archive >> mInputChannel;
-	text_archive >> *(U32*)&mMode;
+	U32 mode;
+	if( text_archive >> mode )
+		mMode = DisplayPortAUXMode( mode );
 	text_archive >> mBitRate;
 	text_archive >> mInverted;
 	text_archive >> mBitsPerTransfer;
-	text_archive >> *(U32*)&mShiftOrder;
+	U32 shift_order;
+	if( text_archive >> shift_order )
+		mShiftOrder = AnalyzerEnums::ShiftOrder( shift_order );
 	text_archive >> mSyncBitsNum;
 
-	DisplayPortAUXTolerance tolerance;
-	if( text_archive >> *(U32*)&tolerance )
-		mTolerance = tolerance;
+	U32 tolerance;
+	if( text_archive >> tolerance )
+		mTolerance = DisplayPortAUXTolerance( tolerance );
 
 	text_archive >> mAbout;
 
+	U32 marker_density;
+	if( text_archive >> marker_density )
+		mMarkerDensity = DisplayPortAUXMarkerDensity( marker_density );
+
+	U32 commit_frames;
+	if( text_archive >> commit_frames )
+		mCommitFrames = commit_frames;
+
+	U32 commit_interval_ms;
+	if( text_archive >> commit_interval_ms )
+		mCommitIntervalMs = commit_interval_ms;
+
+	U32 decode_threads;
+	if( text_archive >> decode_threads )
+		mDecodeThreads = decode_threads;
+
+	bool detect_bit_rate;
+	if( text_archive >> detect_bit_rate )
+		mDetectBitRate = detect_bit_rate;
+
+	U32 sim_scenario;
+	if( text_archive >> sim_scenario )
+		mSimScenario = DisplayPortAUXScenarioType( sim_scenario );
+
+	U32 sim_jitter_percent;
+	if( text_archive >> sim_jitter_percent )
+		mSimJitterPercent = sim_jitter_percent;
+
+	U32 sim_glitch_rate;
+	if( text_archive >> sim_glitch_rate )
+		mSimGlitchRate = sim_glitch_rate;
+
+	U32 deglitch_percent;
+	if( text_archive >> deglitch_percent )
+		mDeglitchPercent = deglitch_percent;
+
+	bool pack_data_frames;
+	if( text_archive >> pack_data_frames )
+		mPackDataFrames = pack_data_frames;
+
 	ClearChannels();
 	AddChannel( mInputChannel, "Display Port AUX", true );
 
@@ -159,6 +319,16 @@ const char* DisplayPortAUXAnalyzerSettings::SaveSettings()
 	text_archive << mSyncBitsNum;
 	text_archive << U32( mTolerance );
 	text_archive << mAbout;
+	text_archive << U32( mMarkerDensity );
+	text_archive << mCommitFrames;
+	text_archive << mCommitIntervalMs;
+	text_archive << mDecodeThreads;
+	text_archive << mDetectBitRate;
+	text_archive << U32( mSimScenario );
+	text_archive << mSimJitterPercent;
+	text_archive << mSimGlitchRate;
+	text_archive << mDeglitchPercent;
+	text_archive << mPackDataFrames;
 
 	return SetReturnString( text_archive.GetString() );
 }
@@ -168,10 +338,20 @@ void DisplayPortAUXAnalyzerSettings::UpdateInterfacesFromSettings()
 	mInputChannelInterface->SetChannel( mInputChannel );
 	mModeInterface->SetNumber( mMode );
 	mBitRateInterface->SetInteger( mBitRate );
+	mDetectBitRateInterface->SetNumber( mDetectBitRate );
 	mInvertedInterface->SetNumber( mInverted );
 	mBitsPerTransferInterface->SetNumber( mBitsPerTransfer );
 	mShiftOrderInterface->SetNumber( mShiftOrder );
 	mSyncBitsNumInterface->SetInteger( mSyncBitsNum );
 	mToleranceInterface->SetNumber( mTolerance );
+	mDeglitchPercentInterface->SetInteger( mDeglitchPercent );
+	mMarkerDensityInterface->SetNumber( mMarkerDensity );
+	mPackDataFramesInterface->SetNumber( mPackDataFrames );
+	mCommitFramesInterface->SetInteger( mCommitFrames );
+	mCommitIntervalMsInterface->SetInteger( mCommitIntervalMs );
+	mDecodeThreadsInterface->SetInteger( mDecodeThreads );
+	mSimScenarioInterface->SetNumber( mSimScenario );
+	mSimJitterPercentInterface->SetInteger( mSimJitterPercent );
+	mSimGlitchRateInterface->SetInteger( mSimGlitchRate );
 	mAboutInterface->SetNumber(mAbout);
 }
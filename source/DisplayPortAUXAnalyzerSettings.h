@@ -3,10 +3,12 @@
 
 #include <AnalyzerSettings.h>
 #include <AnalyzerTypes.h>
+#include "DisplayPortAUXTypes.h"
+#include "DisplayPortAUXTrafficScenario.h"
 
 enum DisplayPortAUXMode { Manchester, FAUX };
-enum DisplayPortAUXTolerance { TOL25, TOL5, TOL05 };
-enum DisplayPortAUXExportType { DpAuxDMP, DpAuxTXT };
+enum DisplayPortAUXTolerance { TOL25, TOL5, TOL05, TOLRECOVERED };
+enum DisplayPortAUXExportType { DpAuxDMP, DpAuxTXT, DpAuxDPCD, DpAuxEDID, DpAuxBIN, DpAuxPCAPNG, DpAuxSTATS, DpAuxDEBUG };
 
 
 class DisplayPortAUXAnalyzerSettings : public AnalyzerSettings
@@ -24,22 +26,42 @@ public:
 	Channel mInputChannel;
 	DisplayPortAUXMode mMode;
 	U32 mBitRate;
+	bool mDetectBitRate;	// from the first edges, mBitRate is the fallback
 	bool mInverted; //non-inverted(false): neg edge = 1; pos edge = 0; inverted(true): neg edge = 0; pos edge = 1;
 	U32 mBitsPerTransfer;
 	AnalyzerEnums::ShiftOrder mShiftOrder;
 	U32 mSyncBitsNum;
 	DisplayPortAUXTolerance mTolerance;
+	U32 mDeglitchPercent;	// of a half bit, narrower pulses are removed; 0: off
+	DisplayPortAUXMarkerDensity mMarkerDensity;
+	bool mPackDataFrames;	// up to 16 data bytes per frame instead of one
+	U32 mCommitFrames;
+	U32 mCommitIntervalMs;
+	U32 mDecodeThreads;	// 1: serial decoder, 0: one per core
+	DisplayPortAUXScenarioType mSimScenario;
+	U32 mSimJitterPercent;	// of a half bit
+	U32 mSimGlitchRate;		// per 10000 runs
 	U32 mAbout;
 
 protected:
 	std::auto_ptr< AnalyzerSettingInterfaceChannel > mInputChannelInterface;
 	std::auto_ptr< AnalyzerSettingInterfaceNumberList >	mModeInterface;
 	std::auto_ptr< AnalyzerSettingInterfaceInteger > mBitRateInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceNumberList > mDetectBitRateInterface;
 	std::auto_ptr< AnalyzerSettingInterfaceNumberList >	mInvertedInterface;
 	std::auto_ptr< AnalyzerSettingInterfaceNumberList > mBitsPerTransferInterface;
 	std::auto_ptr< AnalyzerSettingInterfaceNumberList >	mShiftOrderInterface;
 	std::auto_ptr< AnalyzerSettingInterfaceInteger > mSyncBitsNumInterface;
 	std::auto_ptr< AnalyzerSettingInterfaceNumberList > mToleranceInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceInteger > mDeglitchPercentInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceNumberList > mMarkerDensityInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceNumberList > mPackDataFramesInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceInteger > mCommitFramesInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceInteger > mCommitIntervalMsInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceInteger > mDecodeThreadsInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceNumberList > mSimScenarioInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceInteger > mSimJitterPercentInterface;
+	std::auto_ptr< AnalyzerSettingInterfaceInteger > mSimGlitchRateInterface;
 	std::auto_ptr< AnalyzerSettingInterfaceNumberList > mAboutInterface;
 
 };
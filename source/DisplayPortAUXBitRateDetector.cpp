@@ -0,0 +1,99 @@
+#include "DisplayPortAUXBitRateDetector.h"
+
+DisplayPortAUXBitRateDetector::DisplayPortAUXBitRateDetector( DisplayPortAUXEdgeSource* source, U32 max_edges )
+:	mSource( source ),
+	mMaxEdges( ( max_edges > U32( MinEdges ) ) ? max_edges : U32( MinEdges ) ),
+	mNext( 0 )
+{
+
+}
+
+U32 DisplayPortAUXBitRateDetector::Detect( U32 sample_rate_hz, U32 intervals_per_bit )
+{
+	Prefetch();
+
+	std::vector< U32 > counts( MaxInterval, 0 );
+	for( size_t i = 1; i < mEdges.size(); ++i )
+	{
+		U64 distance = mEdges[ i ] - mEdges[ i - 1 ];
+		if( distance < U64( MaxInterval ) )
+			++counts[ size_t( distance ) ];
+	}
+
+	U32 highest = 0;
+	for( U32 i = 1; i < U32( MaxInterval ); ++i )
+		if( counts[ i ] > highest )
+			highest = counts[ i ];
+	if( highest == 0 )
+		return 0;
+
+	// first strong peak: glitches are rare, so the shortest interval of the line code comes first
+	U32 peak = 1;
+	while( U64( counts[ peak ] ) * PeakFraction < highest )
+		++peak;
+	while( ( peak + 1 < U32( MaxInterval ) ) && ( counts[ peak + 1 ] >= counts[ peak ] ) )
+		++peak;
+
+	// centroid of the bins between half and one and a half times the interval, twice, so a peak that
+	// is split over two bins at low oversampling is weighed correctly; 16.16 fixed point
+	U64 center = U64( peak ) << 16;
+	for( U32 pass = 0; pass < 2; ++pass )
+	{
+		U64 weighted = 0;
+		U64 total = 0;
+		for( U64 i = ( center >> 17 ) + 1; ( i < U64( MaxInterval ) ) && ( ( i << 16 ) <= center + center / 2 ); ++i )
+		{
+			weighted += ( i << 16 ) * counts[ size_t( i ) ];
+			total += counts[ size_t( i ) ];
+		}
+		if( total < U64( MinEdges / PeakFraction ) )
+			return 0;
+		center = weighted / total;
+	}
+
+	U64 divisor = center * ( ( intervals_per_bit != 0 ) ? intervals_per_bit : 1 );
+	return U32( ( ( U64( sample_rate_hz ) << 16 ) + divisor / 2 ) / divisor );
+}
+
+bool DisplayPortAUXBitRateDetector::IsInitiallyHigh()
+{
+	return mSource->IsInitiallyHigh();
+}
+
+U32 DisplayPortAUXBitRateDetector::ReadEdges( U64* edges, U32 max_edges )
+{
+	if( mNext == mEdges.size() )
+		return mSource->ReadEdges( edges, max_edges );
+
+	size_t count = mEdges.size() - mNext;
+	if( count > max_edges )
+		count = max_edges;
+	for( size_t i = 0; i < count; ++i )
+		edges[ i ] = mEdges[ mNext + i ];
+	mNext += count;
+	return U32( count );
+}
+
+bool DisplayPortAUXBitRateDetector::WouldAdvancingToAbsPositionCauseTransition( U64 sample_number )
+{
+	if( mNext < mEdges.size() )
+		return mEdges[ mNext ] <= sample_number;
+	return mSource->WouldAdvancingToAbsPositionCauseTransition( sample_number );	// all edges read so far are handed out
+}
+
+void DisplayPortAUXBitRateDetector::Prefetch()
+{
+	// stops early once it has caught up with the captured data, if that is enough to go by
+	std::vector< U64 > block( 4096 );
+	while( mEdges.size() < mMaxEdges )
+	{
+		U32 wanted = U32( block.size() );
+		if( wanted > mMaxEdges - mEdges.size() )
+			wanted = U32( mMaxEdges - mEdges.size() );
+
+		U32 count = mSource->ReadEdges( &block[ 0 ], wanted );
+		mEdges.insert( mEdges.end(), block.begin(), block.begin() + count );
+		if( ( count == 0 ) || ( ( count < wanted ) && ( mEdges.size() >= U32( MinEdges ) ) ) )
+			break;
+	}
+}
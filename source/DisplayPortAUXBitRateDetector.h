@@ -0,0 +1,45 @@
+#ifndef DISPLAYPORTAUX_BIT_RATE_DETECTOR
+#define DISPLAYPORTAUX_BIT_RATE_DETECTOR
+
+#include "DisplayPortAUXDecoder.h"
+
+// Finds the bit rate from the first edges of a capture, before the decoder starts.
+// Detect() reads at most max_edges edges and histograms the distances between them. Line codes
+// only produce whole multiples of their shortest interval (T, 2T, 4T, 5T half bits for Manchester,
+// 1..5 bits for FAUX), so the first strong peak of the histogram is that interval; its centroid
+// gives the rate with sub-sample resolution. Distances of MaxInterval samples or more (idle lines)
+// are not counted, which bounds the histogram.
+// The edges read by Detect() aren't lost: the detector is an edge source itself and hands them to
+// the decoder first, then passes the source through.
+
+class DisplayPortAUXBitRateDetector : public DisplayPortAUXEdgeSource
+{
+public:
+	enum
+	{
+		DefaultMaxEdges = 16384,
+		MinEdges = 256,			// fewer is not enough to tell, wait for more data
+		MaxInterval = 4096,		// samples, histogram size
+		PeakFraction = 8		// a peak has at least 1/8 of the counts of the highest one
+	};
+
+	DisplayPortAUXBitRateDetector( DisplayPortAUXEdgeSource* source, U32 max_edges = DefaultMaxEdges );
+
+	// bits/s, 0 if the edges have no clear shortest interval
+	// intervals_per_bit: 2 for Manchester (half bits), 1 for NRZ (FAUX)
+	U32 Detect( U32 sample_rate_hz, U32 intervals_per_bit );
+
+	virtual bool IsInitiallyHigh();
+	virtual U32 ReadEdges( U64* edges, U32 max_edges );
+	virtual bool WouldAdvancingToAbsPositionCauseTransition( U64 sample_number );
+
+protected:
+	void Prefetch();
+
+	DisplayPortAUXEdgeSource* mSource;
+	U32 mMaxEdges;
+	std::vector< U64 > mEdges;	// read by Detect(), not returned by ReadEdges() yet from mNext on
+	size_t mNext;
+};
+
+#endif //DISPLAYPORTAUX_BIT_RATE_DETECTOR
@@ -0,0 +1,117 @@
+#include "DisplayPortAUXChannelAdapter.h"
+
+DisplayPortAUXChannelEdgeSource::DisplayPortAUXChannelEdgeSource( Analyzer* analyzer, AnalyzerChannelData* channel_data )
+:	mAnalyzer( analyzer ),
+	mChannelData( channel_data )
+{
+
+}
+
+bool DisplayPortAUXChannelEdgeSource::IsInitiallyHigh()
+{
+	return mChannelData->GetBitState() == BIT_HIGH;
+}
+
+U32 DisplayPortAUXChannelEdgeSource::ReadEdges( U64* edges, U32 max_edges )
+{
+	mAnalyzer->CheckIfThreadShouldExit();
+
+	// the first edge may wait for more data to arrive (live data never runs out), the rest of the block
+	// takes only what is already captured, so the decoder never sits on edges it could have processed
+	U32 count = 0;
+	do
+	{
+		U64 edge = mChannelData->GetSampleOfNextEdge();
+		mChannelData->AdvanceToAbsPosition( edge );
+		edges[ count++ ] = edge;
+	}
+	while( ( count < max_edges ) && mChannelData->DoMoreTransitionsExistInCurrentData() );
+
+	return count;
+}
+
+bool DisplayPortAUXChannelEdgeSource::WouldAdvancingToAbsPositionCauseTransition( U64 sample_number )
+{
+	return mChannelData->WouldAdvancingToAbsPositionCauseTransition( sample_number );
+}
+
+DisplayPortAUXResultsSink::DisplayPortAUXResultsSink( Analyzer* analyzer, AnalyzerResults* results, Channel& channel, bool pack_data )
+:	mAnalyzer( analyzer ),
+	mResults( results ),
+	mChannel( channel ),
+	mPackData( pack_data )
+{
+	mDataBlock.mType = AUXDataBlock;
+	mDataBlock.mFlags = 0;
+}
+
+void DisplayPortAUXResultsSink::AddFrame( const DisplayPortAUXFrame& frame )
+{
+	if( ( mPackData == true ) && ( frame.mType == AUXData ) )
+	{
+		U32 count = DisplayPortAUXDataBlock::GetCount( mDataBlock.mFlags );
+		if( count == 0 )
+		{
+			mDataBlock.mStartingSampleInclusive = frame.mStartingSampleInclusive;
+			mDataBlock.mData1 = 0;
+			mDataBlock.mData2 = 0;
+		}
+		DisplayPortAUXDataBlock::SetByte( mDataBlock.mData1, mDataBlock.mData2, count, U8( frame.mData1 ) );
+		mDataBlock.mEndingSampleInclusive = frame.mEndingSampleInclusive;
+		mDataBlock.mFlags = U8( count + 1 );
+		if( count + 1 == DisplayPortAUXDataBlock::MaxBytes )
+			FlushDataBlock();
+		return;
+	}
+
+	FlushDataBlock();	// any other frame ends the block, the frames stay in order
+
+	Frame result_frame;
+	result_frame.mStartingSampleInclusive = frame.mStartingSampleInclusive;
+	result_frame.mEndingSampleInclusive = frame.mEndingSampleInclusive;
+	result_frame.mData1 = frame.mData1;
+	result_frame.mData2 = frame.mData2;
+	result_frame.mType = frame.mType;
+	result_frame.mFlags = frame.mFlags;
+	mResults->AddFrame( result_frame );
+}
+
+void DisplayPortAUXResultsSink::AddMarkers( const DisplayPortAUXMarker* markers, U32 count )
+{
+	static const AnalyzerResults::MarkerType marker_types[] =	// indexed by DisplayPortAUXMarkerType
+	{
+		AnalyzerResults::Start,
+		AnalyzerResults::Stop,
+		AnalyzerResults::One,
+		AnalyzerResults::Zero,
+		AnalyzerResults::ErrorDot
+	};
+
+	for( U32 i = 0; i < count; ++i )
+		mResults->AddMarker( markers[ i ].mSample, marker_types[ markers[ i ].mType ], mChannel );
+}
+
+void DisplayPortAUXResultsSink::CommitPacket( U32 transaction )
+{
+	FlushDataBlock();
+	U64 packet_id = mResults->CommitPacketAndStartNewPacket();
+	if( transaction != 0 )
+		mResults->AddPacketToTransaction( transaction, packet_id );
+}
+
+void DisplayPortAUXResultsSink::CommitResults( U64 sample_number )
+{
+	// an open block stays open: where commits fall depends on timing and on the decoder threads, the
+	// blocks must not; its bytes show up with the end of their burst
+	mResults->CommitResults();
+	mAnalyzer->ReportProgress( sample_number );
+}
+
+void DisplayPortAUXResultsSink::FlushDataBlock()
+{
+	if( mDataBlock.mFlags == 0 )
+		return;
+
+	mResults->AddFrame( mDataBlock );
+	mDataBlock.mFlags = 0;
+}
@@ -0,0 +1,45 @@
+#ifndef DISPLAYPORTAUX_CHANNEL_ADAPTER
+#define DISPLAYPORTAUX_CHANNEL_ADAPTER
+
+#include <Analyzer.h>
+#include <AnalyzerChannelData.h>
+#include "DisplayPortAUXDecoder.h"
+
+// Glue between the SDK independent DisplayPortAUXDecoder and the AnalyzerSDK objects.
+
+class DisplayPortAUXChannelEdgeSource : public DisplayPortAUXEdgeSource
+{
+public:
+	DisplayPortAUXChannelEdgeSource( Analyzer* analyzer, AnalyzerChannelData* channel_data );
+
+	virtual bool IsInitiallyHigh();
+	virtual U32 ReadEdges( U64* edges, U32 max_edges );
+	virtual bool WouldAdvancingToAbsPositionCauseTransition( U64 sample_number );
+
+protected:
+	Analyzer* mAnalyzer;
+	AnalyzerChannelData* mChannelData;
+};
+
+class DisplayPortAUXResultsSink : public DisplayPortAUXDecoderSink
+{
+public:
+	// pack_data: consecutive data bytes go into AUXDataBlock frames of up to 16 bytes
+	DisplayPortAUXResultsSink( Analyzer* analyzer, AnalyzerResults* results, Channel& channel, bool pack_data );
+
+	virtual void AddFrame( const DisplayPortAUXFrame& frame );
+	virtual void AddMarkers( const DisplayPortAUXMarker* markers, U32 count );
+	virtual void CommitPacket( U32 transaction );
+	virtual void CommitResults( U64 sample_number );
+
+protected:
+	void FlushDataBlock();
+
+	Analyzer* mAnalyzer;
+	AnalyzerResults* mResults;
+	Channel mChannel;
+	bool mPackData;
+	Frame mDataBlock;	// bytes not added to the results yet, their count in mFlags
+};
+
+#endif //DISPLAYPORTAUX_CHANNEL_ADAPTER
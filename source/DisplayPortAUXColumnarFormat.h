@@ -0,0 +1,112 @@
+#ifndef DISPLAYPORTAUX_COLUMNAR_FORMAT
+#define DISPLAYPORTAUX_COLUMNAR_FORMAT
+
+#include "DisplayPortAUXTypes.h"
+
+// Binary columnar export format. It doesn't depend on the SDK, so tools can use it together with
+// DisplayPortAUXColumnarReader.h. All values are little endian.
+//
+//	header		DisplayPortAUXColumnarHeader
+//	chunks		ChunkFrames frames each (the last one may be shorter), 8 byte aligned
+//	directory	one DisplayPortAUXColumnarChunk per chunk
+//	trailer		DisplayPortAUXColumnarTrailer, at the very end of the file
+//
+// A chunk of n frames holds the columns back to back:
+//	U64 data1[ n ], U64 data2[ n ], DisplayPortAUXColumnarBlock blocks[ ( n + BlockFrames - 1 ) / BlockFrames ],
+//	U8 type[ n ], U8 flags[ n ], then the sample stream of mSampleBytes bytes.
+// The sample stream has two LEB128 varints per frame: the distance of its start to the start of the
+// previous frame in the same block (0 for the first one), and its length (end - start). The block
+// table has the absolute start of every block, so finding a frame decodes at most BlockFrames - 1
+// frames.
+
+#define DISPLAYPORTAUX_COLUMNAR_MAGIC "DPAUXCOL"
+#define DISPLAYPORTAUX_COLUMNAR_TRAILER_MAGIC "DPAUXEND"
+
+enum
+{
+	DisplayPortAUXColumnarVersion = 1,
+	DisplayPortAUXColumnarChunkFrames = 65536,
+	DisplayPortAUXColumnarBlockFrames = 256,
+	DisplayPortAUXColumnarMaxVarintBytes = 10
+};
+
+struct DisplayPortAUXColumnarHeader
+{
+	char mMagic[ 8 ];
+	U32 mVersion;
+	U32 mSampleRateHz;
+	S64 mTriggerSample;
+	U32 mChunkFrames;
+	U32 mBlockFrames;
+};
+
+struct DisplayPortAUXColumnarChunk
+{
+	U64 mOffset;		// from the start of the file
+	S64 mFirstSample;	// start of the first frame
+	S64 mLastSample;	// end of the last frame
+	U32 mNumFrames;
+	U32 mSampleBytes;
+};
+
+struct DisplayPortAUXColumnarBlock
+{
+	S64 mStartSample;	// start of the first frame of the block
+	U32 mSampleOffset;	// of its first frame in the sample stream
+	U32 mReserved;
+};
+
+struct DisplayPortAUXColumnarTrailer
+{
+	U64 mNumFrames;
+	U64 mNumChunks;
+	U64 mDirectoryOffset;
+	char mMagic[ 8 ];
+};
+
+// column offsets within a chunk of num_frames frames
+struct DisplayPortAUXColumnarLayout
+{
+	DisplayPortAUXColumnarLayout( U32 num_frames, U32 block_frames )
+	{
+		U64 n = num_frames;
+		mNumBlocks = ( num_frames + block_frames - 1 ) / block_frames;
+		mData1 = 0;
+		mData2 = mData1 + n * sizeof( U64 );
+		mBlocks = mData2 + n * sizeof( U64 );
+		mType = mBlocks + mNumBlocks * sizeof( DisplayPortAUXColumnarBlock );
+		mFlags = mType + n;
+		mSamples = mFlags + n;
+	}
+
+	U32 mNumBlocks;
+	U64 mData1;
+	U64 mData2;
+	U64 mBlocks;
+	U64 mType;
+	U64 mFlags;
+	U64 mSamples;
+};
+
+inline U32 DisplayPortAUXPutVarint( U8* out, U64 value )
+{
+	U32 count = 0;
+	while( value >= 0x80 )
+	{
+		out[ count++ ] = U8( value | 0x80 );
+		value >>= 7;
+	}
+	out[ count++ ] = U8( value );
+	return count;
+}
+
+inline const U8* DisplayPortAUXGetVarint( const U8* in, U64& value )
+{
+	U64 result = *in & 0x7F;
+	for( U32 shift = 7; ( *in++ & 0x80 ) != 0; shift += 7 )
+		result |= U64( *in & 0x7F ) << shift;
+	value = result;
+	return in;
+}
+
+#endif //DISPLAYPORTAUX_COLUMNAR_FORMAT
@@ -0,0 +1,297 @@
+#ifndef DISPLAYPORTAUX_COLUMNAR_READER
+#define DISPLAYPORTAUX_COLUMNAR_READER
+
+#include "DisplayPortAUXColumnarFormat.h"
+#include <string.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Header-only reader for the binary columnar export, for use in post-processing tools; it doesn't
+// depend on the SDK. The file is memory mapped and the columns are used in place: GetData1(),
+// GetData2(), GetTypes() and GetFlags() point straight into the mapping, and frames are only
+// decoded from the sample stream when their samples are needed.
+//
+//	DisplayPortAUXColumnarReader reader;
+//	if( reader.Open( "capture.bin" ) == true )
+//	{
+//		DisplayPortAUXColumnarReader::Cursor cursor = reader.GetCursor( reader.FindFrame( start_sample ) );
+//		DisplayPortAUXFrame frame;
+//		while( ( cursor.Next( frame ) == true ) && ( frame.mStartingSampleInclusive <= end_sample ) )
+//			...
+//	}
+
+class DisplayPortAUXColumnarReader
+{
+public:
+	// sequential decoder, starting at any frame
+	class Cursor
+	{
+	public:
+		Cursor() : mReader( NULL ), mIndex( 0 ), mChunk( 0 ), mInChunk( 0 ), mSamples( NULL ), mStart( 0 ) {}
+
+		bool Next( DisplayPortAUXFrame& frame )
+		{
+			if( ( mReader == NULL ) || ( mIndex >= mReader->GetNumFrames() ) )
+				return false;
+
+			if( mInChunk == mReader->mDirectory[ mChunk ].mNumFrames )
+			{
+				++mChunk;
+				mInChunk = 0;
+			}
+			if( ( mInChunk % mReader->mHeader->mBlockFrames ) == 0 )
+				SeekBlock();
+
+			const DisplayPortAUXColumnarChunk& chunk = mReader->mDirectory[ mChunk ];
+			DisplayPortAUXColumnarLayout layout( chunk.mNumFrames, mReader->mHeader->mBlockFrames );
+			const U8* base = mReader->mBase + chunk.mOffset;
+
+			U64 delta, length;
+			mSamples = DisplayPortAUXGetVarint( mSamples, delta );
+			mSamples = DisplayPortAUXGetVarint( mSamples, length );
+			mStart += S64( delta );
+
+			frame.mStartingSampleInclusive = mStart;
+			frame.mEndingSampleInclusive = mStart + S64( length );
+			frame.mData1 = reinterpret_cast< const U64* >( base + layout.mData1 )[ mInChunk ];
+			frame.mData2 = reinterpret_cast< const U64* >( base + layout.mData2 )[ mInChunk ];
+			frame.mType = base[ layout.mType + mInChunk ];
+			frame.mFlags = base[ layout.mFlags + mInChunk ];
+
+			++mInChunk;
+			++mIndex;
+			return true;
+		}
+
+		U64 GetIndex() const { return mIndex; }	// of the frame the next call to Next() returns
+
+	protected:
+		friend class DisplayPortAUXColumnarReader;
+
+		void Seek( const DisplayPortAUXColumnarReader* reader, U64 index )
+		{
+			mReader = reader;
+			mIndex = index;
+			if( index >= reader->GetNumFrames() )
+				return;
+
+			U32 chunk_frames = reader->mHeader->mChunkFrames;
+			U32 block_frames = reader->mHeader->mBlockFrames;
+			mChunk = index / chunk_frames;
+			mInChunk = U32( index % chunk_frames ) / block_frames * block_frames;
+			SeekBlock();
+
+			// skip to the frame within the block
+			for( U32 i = U32( index % block_frames ); i > 0; --i )
+			{
+				U64 delta, length;
+				mSamples = DisplayPortAUXGetVarint( mSamples, delta );
+				mSamples = DisplayPortAUXGetVarint( mSamples, length );
+				mStart += S64( delta );
+				++mInChunk;
+			}
+		}
+
+		void SeekBlock()
+		{
+			const DisplayPortAUXColumnarChunk& chunk = mReader->mDirectory[ mChunk ];
+			DisplayPortAUXColumnarLayout layout( chunk.mNumFrames, mReader->mHeader->mBlockFrames );
+			const U8* base = mReader->mBase + chunk.mOffset;
+			const DisplayPortAUXColumnarBlock& block = reinterpret_cast< const DisplayPortAUXColumnarBlock* >( base + layout.mBlocks )[ mInChunk / mReader->mHeader->mBlockFrames ];
+
+			mSamples = base + layout.mSamples + block.mSampleOffset;
+			mStart = block.mStartSample;
+		}
+
+		const DisplayPortAUXColumnarReader* mReader;
+		U64 mIndex;
+		U64 mChunk;
+		U32 mInChunk;
+		const U8* mSamples;
+		S64 mStart;
+	};
+
+	DisplayPortAUXColumnarReader() : mBase( NULL ), mSize( 0 ), mHeader( NULL ), mTrailer( NULL ), mDirectory( NULL )
+	{
+#ifdef _WIN32
+		mFile = INVALID_HANDLE_VALUE;
+		mMapping = NULL;
+#endif
+	}
+
+	~DisplayPortAUXColumnarReader()
+	{
+		Close();
+	}
+
+	bool Open( const char* file )
+	{
+		Close();
+
+#ifdef _WIN32
+		mFile = CreateFileA( file, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL );
+		if( mFile == INVALID_HANDLE_VALUE )
+			return false;
+
+		LARGE_INTEGER size;
+		if( GetFileSizeEx( mFile, &size ) == FALSE )
+			return Fail();
+		mSize = U64( size.QuadPart );
+		if( mSize < sizeof( DisplayPortAUXColumnarHeader ) + sizeof( DisplayPortAUXColumnarTrailer ) )
+			return Fail();
+
+		mMapping = CreateFileMappingA( mFile, NULL, PAGE_READONLY, 0, 0, NULL );
+		if( mMapping == NULL )
+			return Fail();
+		mBase = static_cast< const U8* >( MapViewOfFile( mMapping, FILE_MAP_READ, 0, 0, 0 ) );
+		if( mBase == NULL )
+			return Fail();
+#else
+		int fd = open( file, O_RDONLY );
+		if( fd < 0 )
+			return false;
+
+		struct stat info;
+		if( ( fstat( fd, &info ) != 0 ) || ( U64( info.st_size ) < sizeof( DisplayPortAUXColumnarHeader ) + sizeof( DisplayPortAUXColumnarTrailer ) ) )
+		{
+			close( fd );
+			return false;
+		}
+		mSize = U64( info.st_size );
+
+		void* base = mmap( NULL, size_t( mSize ), PROT_READ, MAP_SHARED, fd, 0 );
+		close( fd );	// the mapping keeps the file open
+		if( base == MAP_FAILED )
+			return false;
+		mBase = static_cast< const U8* >( base );
+#endif
+
+		mHeader = reinterpret_cast< const DisplayPortAUXColumnarHeader* >( mBase );
+		mTrailer = reinterpret_cast< const DisplayPortAUXColumnarTrailer* >( mBase + mSize - sizeof( DisplayPortAUXColumnarTrailer ) );
+		if( ( memcmp( mHeader->mMagic, DISPLAYPORTAUX_COLUMNAR_MAGIC, sizeof( mHeader->mMagic ) ) != 0 ) ||
+			( memcmp( mTrailer->mMagic, DISPLAYPORTAUX_COLUMNAR_TRAILER_MAGIC, sizeof( mTrailer->mMagic ) ) != 0 ) ||
+			( mHeader->mVersion != DisplayPortAUXColumnarVersion ) ||
+			( mHeader->mChunkFrames == 0 ) || ( mHeader->mBlockFrames == 0 ) ||
+			( mTrailer->mDirectoryOffset + mTrailer->mNumChunks * sizeof( DisplayPortAUXColumnarChunk ) + sizeof( DisplayPortAUXColumnarTrailer ) != mSize ) )
+			return Fail();
+
+		mDirectory = reinterpret_cast< const DisplayPortAUXColumnarChunk* >( mBase + mTrailer->mDirectoryOffset );
+		return true;
+	}
+
+	void Close()
+	{
+#ifdef _WIN32
+		if( mBase != NULL )
+			UnmapViewOfFile( mBase );
+		if( mMapping != NULL )
+			CloseHandle( mMapping );
+		if( mFile != INVALID_HANDLE_VALUE )
+			CloseHandle( mFile );
+		mFile = INVALID_HANDLE_VALUE;
+		mMapping = NULL;
+#else
+		if( mBase != NULL )
+			munmap( const_cast< U8* >( mBase ), size_t( mSize ) );
+#endif
+		mBase = NULL;
+		mSize = 0;
+		mHeader = NULL;
+		mTrailer = NULL;
+		mDirectory = NULL;
+	}
+
+	bool IsOpen() const { return mDirectory != NULL; }
+	U32 GetSampleRateHz() const { return mHeader->mSampleRateHz; }
+	S64 GetTriggerSample() const { return mHeader->mTriggerSample; }
+	U64 GetNumFrames() const { return mTrailer->mNumFrames; }
+
+	// chunks, and their columns in place
+	U64 GetNumChunks() const { return mTrailer->mNumChunks; }
+	const DisplayPortAUXColumnarChunk& GetChunk( U64 chunk ) const { return mDirectory[ chunk ]; }
+	const U64* GetData1( U64 chunk ) const { return reinterpret_cast< const U64* >( GetColumn( chunk, Layout( chunk ).mData1 ) ); }
+	const U64* GetData2( U64 chunk ) const { return reinterpret_cast< const U64* >( GetColumn( chunk, Layout( chunk ).mData2 ) ); }
+	const U8* GetTypes( U64 chunk ) const { return GetColumn( chunk, Layout( chunk ).mType ); }
+	const U8* GetFlags( U64 chunk ) const { return GetColumn( chunk, Layout( chunk ).mFlags ); }
+
+	Cursor GetCursor( U64 index ) const
+	{
+		Cursor cursor;
+		cursor.Seek( this, index );
+		return cursor;
+	}
+
+	bool GetFrame( U64 index, DisplayPortAUXFrame& frame ) const
+	{
+		Cursor cursor = GetCursor( index );
+		return cursor.Next( frame );
+	}
+
+	// index of the first frame that ends at or after sample_number, GetNumFrames() if there is none
+	U64 FindFrame( S64 sample_number ) const
+	{
+		U64 chunk_count = GetNumChunks();
+		U64 low = 0;
+		U64 high = chunk_count;
+		while( low < high )	// first chunk that ends at or after sample_number
+		{
+			U64 middle = ( low + high ) / 2;
+			if( mDirectory[ middle ].mLastSample < sample_number )
+				low = middle + 1;
+			else
+				high = middle;
+		}
+		if( low == chunk_count )
+			return GetNumFrames();
+
+		// last block of the chunk that starts at or before sample_number, then scan
+		const DisplayPortAUXColumnarChunk& chunk = mDirectory[ low ];
+		DisplayPortAUXColumnarLayout layout = Layout( low );
+		const DisplayPortAUXColumnarBlock* blocks = reinterpret_cast< const DisplayPortAUXColumnarBlock* >( mBase + chunk.mOffset + layout.mBlocks );
+		U32 block = 0;
+		while( ( block + 1 < layout.mNumBlocks ) && ( blocks[ block + 1 ].mStartSample <= sample_number ) )
+			++block;
+
+		Cursor cursor = GetCursor( low * mHeader->mChunkFrames + U64( block ) * mHeader->mBlockFrames );
+		DisplayPortAUXFrame frame;
+		for( U64 index = cursor.GetIndex(); cursor.Next( frame ) == true; ++index )
+		{
+			if( frame.mEndingSampleInclusive >= sample_number )
+				return index;
+		}
+		return GetNumFrames();
+	}
+
+protected:
+	bool Fail()
+	{
+		Close();
+		return false;
+	}
+
+	DisplayPortAUXColumnarLayout Layout( U64 chunk ) const { return DisplayPortAUXColumnarLayout( mDirectory[ chunk ].mNumFrames, mHeader->mBlockFrames ); }
+	const U8* GetColumn( U64 chunk, U64 offset ) const { return mBase + mDirectory[ chunk ].mOffset + offset; }
+
+	const U8* mBase;
+	U64 mSize;
+	const DisplayPortAUXColumnarHeader* mHeader;
+	const DisplayPortAUXColumnarTrailer* mTrailer;
+	const DisplayPortAUXColumnarChunk* mDirectory;
+
+#ifdef _WIN32
+	HANDLE mFile;
+	HANDLE mMapping;
+#endif
+};
+
+#endif //DISPLAYPORTAUX_COLUMNAR_READER
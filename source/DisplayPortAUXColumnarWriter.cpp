@@ -0,0 +1,112 @@
+#include "DisplayPortAUXColumnarWriter.h"
+#include <string.h>
+
+DisplayPortAUXColumnarWriter::DisplayPortAUXColumnarWriter( DisplayPortAUXExportWriter* out, U32 sample_rate_hz, S64 trigger_sample )
+:	mOut( out ),
+	mOffset( 0 ),
+	mNumFrames( 0 ),
+	mSamples( DisplayPortAUXColumnarChunkFrames * 2 * DisplayPortAUXColumnarMaxVarintBytes ),
+	mSampleBytes( 0 ),
+	mPreviousStart( 0 ),
+	mLastSample( 0 )
+{
+	mData1.reserve( DisplayPortAUXColumnarChunkFrames );
+	mData2.reserve( DisplayPortAUXColumnarChunkFrames );
+	mBlocks.reserve( DisplayPortAUXColumnarChunkFrames / DisplayPortAUXColumnarBlockFrames );
+	mType.reserve( DisplayPortAUXColumnarChunkFrames );
+	mFlags.reserve( DisplayPortAUXColumnarChunkFrames );
+
+	DisplayPortAUXColumnarHeader header;
+	memset( &header, 0, sizeof( header ) );
+	memcpy( header.mMagic, DISPLAYPORTAUX_COLUMNAR_MAGIC, sizeof( header.mMagic ) );
+	header.mVersion = DisplayPortAUXColumnarVersion;
+	header.mSampleRateHz = sample_rate_hz;
+	header.mTriggerSample = trigger_sample;
+	header.mChunkFrames = DisplayPortAUXColumnarChunkFrames;
+	header.mBlockFrames = DisplayPortAUXColumnarBlockFrames;
+	Write( &header, sizeof( header ) );
+}
+
+void DisplayPortAUXColumnarWriter::AddFrame( const DisplayPortAUXFrame& frame )
+{
+	U32 index = U32( mData1.size() );
+	if( ( index % DisplayPortAUXColumnarBlockFrames ) == 0 )
+	{
+		DisplayPortAUXColumnarBlock block;
+		block.mStartSample = frame.mStartingSampleInclusive;
+		block.mSampleOffset = mSampleBytes;
+		block.mReserved = 0;
+		mBlocks.push_back( block );
+		mPreviousStart = frame.mStartingSampleInclusive;
+	}
+
+	mData1.push_back( frame.mData1 );
+	mData2.push_back( frame.mData2 );
+	mType.push_back( frame.mType );
+	mFlags.push_back( frame.mFlags );
+
+	U8* out = &mSamples[ mSampleBytes ];
+	out += DisplayPortAUXPutVarint( out, U64( frame.mStartingSampleInclusive - mPreviousStart ) );
+	out += DisplayPortAUXPutVarint( out, U64( frame.mEndingSampleInclusive - frame.mStartingSampleInclusive ) );
+	mSampleBytes = U32( out - &mSamples[ 0 ] );
+	mPreviousStart = frame.mStartingSampleInclusive;
+	mLastSample = frame.mEndingSampleInclusive;
+
+	++mNumFrames;
+	if( mData1.size() == DisplayPortAUXColumnarChunkFrames )
+		WriteChunk();
+}
+
+void DisplayPortAUXColumnarWriter::Finish()
+{
+	if( mData1.empty() == false )
+		WriteChunk();
+
+	DisplayPortAUXColumnarTrailer trailer;
+	memset( &trailer, 0, sizeof( trailer ) );
+	trailer.mNumFrames = mNumFrames;
+	trailer.mNumChunks = mDirectory.size();
+	trailer.mDirectoryOffset = mOffset;
+	memcpy( trailer.mMagic, DISPLAYPORTAUX_COLUMNAR_TRAILER_MAGIC, sizeof( trailer.mMagic ) );
+
+	if( mDirectory.empty() == false )
+		Write( &mDirectory[ 0 ], mDirectory.size() * sizeof( DisplayPortAUXColumnarChunk ) );
+	Write( &trailer, sizeof( trailer ) );
+}
+
+void DisplayPortAUXColumnarWriter::WriteChunk()
+{
+	U32 num_frames = U32( mData1.size() );
+
+	DisplayPortAUXColumnarChunk chunk;
+	chunk.mOffset = mOffset;
+	chunk.mFirstSample = mBlocks[ 0 ].mStartSample;
+	chunk.mLastSample = mLastSample;
+	chunk.mNumFrames = num_frames;
+	chunk.mSampleBytes = mSampleBytes;
+	mDirectory.push_back( chunk );
+
+	Write( &mData1[ 0 ], num_frames * sizeof( U64 ) );
+	Write( &mData2[ 0 ], num_frames * sizeof( U64 ) );
+	Write( &mBlocks[ 0 ], mBlocks.size() * sizeof( DisplayPortAUXColumnarBlock ) );
+	Write( &mType[ 0 ], num_frames );
+	Write( &mFlags[ 0 ], num_frames );
+	Write( &mSamples[ 0 ], mSampleBytes );
+
+	static const U8 padding[ 8 ] = { 0 };
+	if( ( mOffset & 7 ) != 0 )
+		Write( padding, 8 - ( mOffset & 7 ) );
+
+	mData1.clear();
+	mData2.clear();
+	mBlocks.clear();
+	mType.clear();
+	mFlags.clear();
+	mSampleBytes = 0;
+}
+
+void DisplayPortAUXColumnarWriter::Write( const void* data, U64 length )
+{
+	mOut->Append( data, U32( length ) );
+	mOffset += length;
+}
@@ -0,0 +1,41 @@
+#ifndef DISPLAYPORTAUX_COLUMNAR_WRITER
+#define DISPLAYPORTAUX_COLUMNAR_WRITER
+
+#include "DisplayPortAUXColumnarFormat.h"
+#include "DisplayPortAUXExportWriter.h"
+#include <vector>
+
+// Writes frames in the binary columnar format (see DisplayPortAUXColumnarFormat.h). Frames are
+// collected one chunk at a time and written column by column; the directory and the trailer go at
+// the end, so the output is written strictly in order.
+
+class DisplayPortAUXColumnarWriter
+{
+public:
+	DisplayPortAUXColumnarWriter( DisplayPortAUXExportWriter* out, U32 sample_rate_hz, S64 trigger_sample );
+
+	void AddFrame( const DisplayPortAUXFrame& frame );	// in sample order
+	void Finish();
+
+protected:
+	void WriteChunk();
+	void Write( const void* data, U64 length );
+
+	DisplayPortAUXExportWriter* mOut;
+	U64 mOffset;
+	U64 mNumFrames;
+
+	std::vector< U64 > mData1;
+	std::vector< U64 > mData2;
+	std::vector< DisplayPortAUXColumnarBlock > mBlocks;
+	std::vector< U8 > mType;
+	std::vector< U8 > mFlags;
+	std::vector< U8 > mSamples;
+	U32 mSampleBytes;
+	S64 mPreviousStart;
+	S64 mLastSample;
+
+	std::vector< DisplayPortAUXColumnarChunk > mDirectory;
+};
+
+#endif //DISPLAYPORTAUX_COLUMNAR_WRITER
@@ -0,0 +1,33 @@
+#include "DisplayPortAUXCommitScheduler.h"
+
+DisplayPortAUXCommitScheduler::DisplayPortAUXCommitScheduler()
+:	mMaxFrames( 1 ),
+	mMaxInterval( Clock::duration::zero() ),
+	mPendingFrames( 0 ),
+	mLastCommit( Clock::now() )
+{
+
+}
+
+void DisplayPortAUXCommitScheduler::Init( U32 max_frames, U32 max_interval_ms )
+{
+	mMaxFrames = ( max_frames == 0 ) ? 1 : max_frames;
+	mMaxInterval = std::chrono::duration_cast< Clock::duration >( std::chrono::milliseconds( max_interval_ms ) );
+	mPendingFrames = 0;
+	mLastCommit = Clock::now();
+}
+
+bool DisplayPortAUXCommitScheduler::IsDue()
+{
+	if( mPendingFrames == 0 )
+		return false;
+	if( mPendingFrames >= mMaxFrames )
+		return true;
+	return ( Clock::now() - mLastCommit ) >= mMaxInterval;
+}
+
+void DisplayPortAUXCommitScheduler::Committed()
+{
+	mPendingFrames = 0;
+	mLastCommit = Clock::now();
+}
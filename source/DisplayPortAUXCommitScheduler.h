@@ -0,0 +1,33 @@
+#ifndef DISPLAYPORTAUX_COMMIT_SCHEDULER
+#define DISPLAYPORTAUX_COMMIT_SCHEDULER
+
+#include "DisplayPortAUXTypes.h"
+#include <chrono>
+
+// Decides when decoded results are committed to the UI. Every commit wakes the UI and takes the
+// results lock, so frames are committed in batches: after max_frames frames or max_interval_ms
+// milliseconds, whichever comes first. The decoder still forces a commit at burst boundaries and
+// before it waits for more data.
+
+class DisplayPortAUXCommitScheduler
+{
+public:
+	DisplayPortAUXCommitScheduler();
+
+	void Init( U32 max_frames, U32 max_interval_ms );
+
+	void FrameAdded() { ++mPendingFrames; }
+	bool HasPending() const { return mPendingFrames != 0; }
+	bool IsDue();
+	void Committed();
+
+protected:
+	typedef std::chrono::steady_clock Clock;
+
+	U32 mMaxFrames;
+	Clock::duration mMaxInterval;
+	U32 mPendingFrames;
+	Clock::time_point mLastCommit;
+};
+
+#endif //DISPLAYPORTAUX_COMMIT_SCHEDULER
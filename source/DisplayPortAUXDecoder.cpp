@@ -0,0 +1,528 @@
+#include "DisplayPortAUXDecoder.h"
+
+DisplayPortAUXDecoder::DisplayPortAUXDecoder( const DisplayPortAUXDecoderConfig& config, DisplayPortAUXEdgeSource* source, DisplayPortAUXDecoderSink* sink )
+:	mConfig( config ),
+	mSource( source ),
+	mSink( sink ),
+	mEdges( EdgeBufferSize ),
+	mDistances( EdgeBufferSize ),
+	mIntervals( EdgeBufferSize ),
+	mEdgeCount( 0 ),
+	mEdgeIndex( 0 ),
+	mMarkerMask( 0 ),
+	mMarkers( MarkerBufferSize ),
+	mMarkerCount( 0 ),
+	mPendingSample( 0 ),
+	mSample( 0 ),
+	mInterval( AUXIntervalInvalid ),
+	mHigh( false ),
+	mSynchronized( false ),
+	mSkipToIdle( false ),
+	mPacketNum( 0 )
+{
+	mFrame.mStartingSampleInclusive = 0;
+	mFrame.mEndingSampleInclusive = 0;
+	mFrame.mData1 = 0;
+	mFrame.mData2 = 0;
+	mFrame.mType = AUXSync;
+	mFrame.mFlags = 0;
+
+	mClassifier.Init( mConfig.mT, mConfig.mTError );
+	if( mConfig.mBitRate != 0 )
+		mRecovery.Init( ( U64( mConfig.mSampleRateHz ) << 16 ) / ( 2 * U64( mConfig.mBitRate ) ) );
+
+	mTransactions.Init( mConfig.mSampleRateHz, mConfig.mDpcd, mConfig.mEdid, mConfig.mStatistics );
+	mCommitScheduler.Init( mConfig.mCommitFrames, mConfig.mCommitIntervalMs );
+
+	// the same masks as the policies, for the code that isn't instantiated per policy
+	switch( mConfig.mMarkerDensity )
+	{
+	case MarkersAllBits:
+		mMarkerMask = DisplayPortAUXDecodePolicy< false, MarkersAllBits, false >::MarkerMask;
+		break;
+	case MarkersStartStopErrors:
+		mMarkerMask = DisplayPortAUXDecodePolicy< false, MarkersStartStopErrors, false >::MarkerMask;
+		break;
+	case MarkersNone:
+		mMarkerMask = DisplayPortAUXDecodePolicy< false, MarkersNone, false >::MarkerMask;
+		break;
+	}
+}
+
+DisplayPortAUXDecoder::~DisplayPortAUXDecoder()
+{
+
+}
+
+void DisplayPortAUXDecoder::Run()
+{
+	mHigh = mSource->IsInitiallyHigh();
+	mSynchronized = false;
+	mSkipToIdle = false;
+	mPacketNum = 0;
+	mEdgeCount = 0;
+	mEdgeIndex = 0;
+	mMarkerCount = 0;
+	mTransactions.Init( mConfig.mSampleRateHz, mConfig.mDpcd, mConfig.mEdid, mConfig.mStatistics );
+	mCommitScheduler.Init( mConfig.mCommitFrames, mConfig.mCommitIntervalMs );
+	mCounters = DisplayPortAUXDecoderCounters();
+	mRunStart = std::chrono::steady_clock::now();
+
+	Decode();
+
+	EndBurst();	// out of edges
+	CommitResults( mPendingSample, true );
+	PublishCounters();
+}
+
+void DisplayPortAUXDecoder::Decode()
+{
+	U32 variant = U32( mConfig.mMarkerDensity ) * 4 + ( mConfig.mClockRecovery ? 2 : 0 ) + ( mConfig.mInverted ? 1 : 0 );
+	switch( variant )
+	{
+	case 0:		DecodeWith< DisplayPortAUXDecodePolicy< false, MarkersAllBits, false > >();				break;
+	case 1:		DecodeWith< DisplayPortAUXDecodePolicy< true, MarkersAllBits, false > >();				break;
+	case 2:		DecodeWith< DisplayPortAUXDecodePolicy< false, MarkersAllBits, true > >();				break;
+	case 3:		DecodeWith< DisplayPortAUXDecodePolicy< true, MarkersAllBits, true > >();				break;
+	case 4:		DecodeWith< DisplayPortAUXDecodePolicy< false, MarkersStartStopErrors, false > >();		break;
+	case 5:		DecodeWith< DisplayPortAUXDecodePolicy< true, MarkersStartStopErrors, false > >();		break;
+	case 6:		DecodeWith< DisplayPortAUXDecodePolicy< false, MarkersStartStopErrors, true > >();		break;
+	case 7:		DecodeWith< DisplayPortAUXDecodePolicy< true, MarkersStartStopErrors, true > >();		break;
+	case 8:		DecodeWith< DisplayPortAUXDecodePolicy< false, MarkersNone, false > >();				break;
+	case 9:		DecodeWith< DisplayPortAUXDecodePolicy< true, MarkersNone, false > >();					break;
+	case 10:	DecodeWith< DisplayPortAUXDecodePolicy< false, MarkersNone, true > >();					break;
+	case 11:	DecodeWith< DisplayPortAUXDecodePolicy< true, MarkersNone, true > >();					break;
+	}
+}
+
+template< class Policy > void DisplayPortAUXDecoder::DecodeWith()
+{
+	if( Advance< Policy >() == true )
+	{
+		while( ( Synchronize< Policy >() == true ) && ( CollectData< Policy >() == true ) )
+		{
+		}
+	}
+}
+
+void DisplayPortAUXDecoder::ClassifyEdges( U32 count )
+{
+	if( mConfig.mClockRecovery == true )
+		return;	// the classes depend on the clock at every edge, Advance() classifies
+	mClassifier.ClassifyBlock( &mDistances[ 0 ], &mIntervals[ 0 ], count );
+}
+
+bool DisplayPortAUXDecoder::FillEdgeBuffer()
+{
+	CommitResults( mPendingSample, true );	// reading may block waiting for data (or end the thread), publish everything first
+
+	std::chrono::steady_clock::time_point read_start = std::chrono::steady_clock::now();
+	U32 count = mSource->ReadEdges( &mEdges[ 0 ], EdgeBufferSize );
+	mCounters.mSourceNs += std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - read_start ).count();
+	if( count == 0 )
+		return false;
+	mCounters.mEdges += count;
+
+	U64 previous = mSample;
+	for( U32 i = 0; i < count; ++i )
+	{
+		mDistances[ i ] = mEdges[ i ] - previous;
+		previous = mEdges[ i ];
+	}
+	ClassifyEdges( count );
+
+	mEdgeCount = count;
+	mEdgeIndex = 0;
+	return true;
+}
+
+template< class Policy > bool DisplayPortAUXDecoder::Advance()
+{
+	if( ( mEdgeIndex == mEdgeCount ) && ( FillEdgeBuffer() == false ) )
+		return false;
+
+	mSample = mEdges[ mEdgeIndex ];
+	if( Policy::UsesClockRecovery == true )
+	{
+		mInterval = mRecovery.Classify( mDistances[ mEdgeIndex ] );
+		if( mSynchronized == true )
+			mRecovery.Track( mDistances[ mEdgeIndex ], mInterval );
+	}
+	else
+	{
+		mInterval = mIntervals[ mEdgeIndex ];
+	}
+	++mEdgeIndex;
+	mHigh = !mHigh;
+	return true;
+}
+
+bool DisplayPortAUXDecoder::IsIdleFor( U32 num_samples )
+{
+	if( mEdgeIndex < mEdgeCount )
+		return mEdges[ mEdgeIndex ] > mSample + num_samples;
+	return !mSource->WouldAdvancingToAbsPositionCauseTransition( mSample + num_samples );	// the source is positioned at mSample
+}
+
+bool DisplayPortAUXDecoder::SkipToIdle()
+{
+	// stops on the last edge before the gap, the SYNC hunt sees the gap as its first interval
+	U64 idle = U64( ResyncIdleHalfBits ) * mConfig.mT;
+	if( ( mEdgeIndex != 0 ) && ( mDistances[ mEdgeIndex - 1 ] > idle ) )
+		return true;	// the error was on the first edge after a gap, that edge may start the next burst
+
+	for( ; ; )
+	{
+		for( ; mEdgeIndex < mEdgeCount; ++mEdgeIndex )
+		{
+			if( mDistances[ mEdgeIndex ] > idle )
+				return true;
+			mSample = mEdges[ mEdgeIndex ];
+			mHigh = !mHigh;
+			++mCounters.mSkippedEdges;
+		}
+
+		if( FillEdgeBuffer() == false )
+			return false;
+	}
+}
+
+void DisplayPortAUXDecoder::AddMarker( U64 sample_number, DisplayPortAUXMarkerType marker_type )
+{
+	if( ( mMarkerMask & ( 1 << marker_type ) ) != 0 )
+		StoreMarker( sample_number, marker_type );
+}
+
+template< class Policy > void DisplayPortAUXDecoder::AddMarker( U64 sample_number, DisplayPortAUXMarkerType marker_type )
+{
+	if( ( Policy::MarkerMask & ( 1 << marker_type ) ) != 0 )
+		StoreMarker( sample_number, marker_type );
+}
+
+void DisplayPortAUXDecoder::StoreMarker( U64 sample_number, DisplayPortAUXMarkerType marker_type )
+{
+	mMarkers[ mMarkerCount ].mSample = sample_number;
+	mMarkers[ mMarkerCount ].mType = marker_type;
+	if( ++mMarkerCount == MarkerBufferSize )
+		FlushMarkers();
+}
+
+void DisplayPortAUXDecoder::ReportError( U64 sample_number, DisplayPortAUXDecodeError error )
+{
+	AddMarker( sample_number, AUXMarkerError );
+	++mCounters.mErrors[ error ];
+	++mCounters.mSyncLost;
+	mSkipToIdle = true;
+}
+
+void DisplayPortAUXDecoder::PublishCounters()
+{
+	if( mConfig.mStatistics == NULL )
+		return;
+
+	U64 run_ns = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - mRunStart ).count();
+	mCounters.mDecodeNs = ( run_ns > mCounters.mSourceNs ) ? run_ns - mCounters.mSourceNs : 0;
+	mCounters.mGlitches = mSource->GetGlitchCount();
+	mConfig.mStatistics->SetDecoderCounters( mCounters );
+}
+
+void DisplayPortAUXDecoder::FlushMarkers()
+{
+	if( mMarkerCount == 0 )
+		return;
+
+	mSink->AddMarkers( &mMarkers[ 0 ], mMarkerCount );
+	mMarkerCount = 0;
+}
+
+void DisplayPortAUXDecoder::AddFrame()
+{
+	if( mFrame.mType == AUXData )
+		++mCounters.mBytes;
+	else if( mFrame.mType == AUXStop )
+		++mCounters.mBursts;
+	else if( mFrame.mType == AUXStart )
+		++mCounters.mSyncAcquired;
+
+	mTransactions.AddFrame( mFrame );
+	mSink->AddFrame( mFrame );
+	mPendingSample = mFrame.mEndingSampleInclusive;
+	mCommitScheduler.FrameAdded();
+}
+
+void DisplayPortAUXDecoder::CommitResults( U64 sample_number, bool force )
+{
+	if( force ? !mCommitScheduler.HasPending() : !mCommitScheduler.IsDue() )
+	{
+		if( force )
+			FlushMarkers();	// error markers may be pending without any frame
+		return;
+	}
+
+	FlushMarkers();
+	PublishCounters();
+	mSink->CommitResults( sample_number );
+	mCommitScheduler.Committed();
+}
+
+void DisplayPortAUXDecoder::EndBurst()
+{
+	if( mTransactions.IsBurstOpen() == false )
+		return;
+
+	mSink->CommitPacket( mTransactions.EndBurst() );
+	CommitResults( mPendingSample, true );	// always commit a finished burst
+}
+
+template< class Policy > bool DisplayPortAUXDecoder::Synchronize()
+{
+	// Look for valid SYNC sequence
+	U32 sync_count = 0;
+	mFrame.mStartingSampleInclusive = mSample;
+	mRecovery.Reset();	// every SYNC is measured on its own
+	while( mSynchronized == false )
+	{
+		if( mSkipToIdle == true )
+		{
+			mSkipToIdle = false;
+			if( SkipToIdle() == false )
+				return false;
+			sync_count = 0;
+			mRecovery.Reset();
+		}
+
+		U64 edge_location = mSample;
+		if( Advance< Policy >() == false )
+			return false;
+
+		if( ( Policy::UsesClockRecovery == true ) && !( mInterval & AUXIntervalT ) && ( sync_count >= ( 2 * mConfig.mSyncBitsNum ) ) )
+		{
+			// end of a SYNC: measure its clock and classify the possible START with it
+			mRecovery.SetFromSync( edge_location - mFrame.mStartingSampleInclusive, sync_count );
+			mInterval = mRecovery.Classify( mSample - edge_location );
+			mRecovery.Track( mSample - edge_location, mInterval );
+		}
+
+		if( mInterval & AUXIntervalT )	// short = consecutive equal bits (assuming 0s)
+		{
+			if( sync_count == 0 )
+				mFrame.mStartingSampleInclusive = edge_location;
+			sync_count++;	// counting short periods
+			if( Policy::UsesClockRecovery == true )
+				mRecovery.AddSyncEdge( mSample - mFrame.mStartingSampleInclusive );
+		}
+		else if( ( mInterval & AUXInterval5T ) && ( sync_count >= ( 2 * mConfig.mSyncBitsNum ) ) )	// long = possible START symbol
+		{
+			mFrame.mEndingSampleInclusive = edge_location + HalfPeriod< Policy >();
+			if( mHigh == false )
+			{
+				U64 start_middle = mSample;
+				if( Advance< Policy >() == false )
+					return false;
+				if( Policy::UsesClockRecovery == true )
+					mRecovery.Track( mSample - start_middle, mInterval );
+
+				if( mInterval & AUXInterval5T )	// long = START symbol, next data is 0.
+				{
+					mSynchronized = true;
+					AddMarker< Policy >( mSample - HalfPeriod< Policy >(), AUXMarkerStart );
+					ReportSync< Policy >( sync_count, mSample - HalfPeriod< Policy >() );
+				}
+				else if( mInterval & AUXInterval4T )	// long = START symbol, next data is 1.
+				{
+					mSynchronized = true;
+					AddMarker< Policy >( mSample, AUXMarkerStart );
+					ReportSync< Policy >( sync_count, mSample );
+
+					// check and skip 1st half-period of data bit
+					if( Advance< Policy >() == false )
+						return false;
+					if( !( mInterval & AUXIntervalT ) )	// if not short, next bit is invalid
+					{
+						mSynchronized = false;
+						ReportError( mSample, AUXErrorStartFirstBit );
+						EndBurst();
+					}
+				}
+				else
+				{
+					sync_count = 0;	// invalid START
+					mRecovery.Reset();
+					++mCounters.mErrors[ AUXErrorStartSecondHalf ];
+				}
+			}
+			else
+			{
+				sync_count = 0;	// invalid START
+				mRecovery.Reset();
+				++mCounters.mErrors[ AUXErrorStartSecondHalf ];
+			}
+		}
+		else
+		{
+			sync_count = 0;	// long, but not START symbol; reset counter
+			mRecovery.Reset();
+		}
+	}
+	return true;
+}
+
+template< class Policy > void DisplayPortAUXDecoder::ReportSync( U32 sync_count, U64 start_end )
+{
+	// report SYNC frame
+	mFrame.mData1 = sync_count / 2;
+	mFrame.mData2 = ( U64( mConfig.mSampleRateHz ) * sync_count / 2 ) / ( mFrame.mEndingSampleInclusive - mFrame.mStartingSampleInclusive - HalfPeriod< Policy >() );
+	mFrame.mType = AUXSync;
+	mFrame.mFlags = 0;
+	AddFrame();
+
+	// report START symbol
+	mFrame.mStartingSampleInclusive = mFrame.mEndingSampleInclusive + 1;
+	mFrame.mEndingSampleInclusive = start_end;
+	mFrame.mData1 = ++mPacketNum;
+	mFrame.mType = AUXStart;
+	mFrame.mFlags = 0;
+	AddFrame();
+
+	CommitResults( mFrame.mEndingSampleInclusive, false );
+}
+
+template< class Policy > bool DisplayPortAUXDecoder::CollectData()
+{
+	mFrame.mEndingSampleInclusive = mSample - HalfPeriod< Policy >();	// preparing frame margin in advance
+	while( mSynchronized == true )
+	{
+		// Get data byte
+		U32 value = 0;
+		mFrame.mStartingSampleInclusive = mFrame.mEndingSampleInclusive + 1;
+		for( U32 i = 0; i < 8; ++i )	// Collect 8 bit data
+		{
+			// Collecting current bit
+			value <<= 1;
+			if( mHigh == Policy::IsInverted )	// neg edge is one; pos edge is one when inverted
+			{
+				value |= 1;
+				AddMarker< Policy >( mSample, AUXMarkerOne );
+			}
+			else
+				AddMarker< Policy >( mSample, AUXMarkerZero );	// another cases represents zero
+
+			if( i < 7 )	// need advance for first 7 bits only
+			{
+				if( Advance< Policy >() == false )
+					return false;
+
+				if( mInterval & AUXIntervalT )	// consecutive equal bits, need advance to next edge
+				{
+					if( Advance< Policy >() == false )
+						return false;
+					if( !( mInterval & AUXIntervalT ) )	// wrong interval
+					{
+						ReportError( mSample, AUXErrorDataHalfBit );
+						mSynchronized = false;
+						break;
+					}
+				}
+				else if( !( mInterval & AUXInterval2T ) )	// wrong interval
+				{
+					ReportError( mSample, AUXErrorDataInterval );
+					mSynchronized = false;
+					break;
+				}
+			}
+		}	// Collect 8 bit data
+
+		if( mSynchronized == true )	// if valid byte collected
+		{
+			mFrame.mEndingSampleInclusive = mSample + HalfPeriod< Policy >();
+			mFrame.mData1 = value;
+			mFrame.mType = AUXData;
+			mFrame.mFlags = 0;
+			AddFrame();
+			CommitResults( mFrame.mEndingSampleInclusive, false );
+
+			// check for potential STOP symbol
+			if( Advance< Policy >() == false )
+				return false;
+
+			if( mInterval & AUXIntervalT )	// consecutive equal bits, need advance to next edge
+			{
+				if( Advance< Policy >() == false )
+					return false;
+				if( !( mInterval & AUXIntervalT ) )	// not a data bit interval
+				{
+					if( mInterval & AUXInterval4T )	// potential STOP
+						CheckStop< Policy >();
+					else
+					{
+						ReportError( mSample, AUXErrorStopHalfBit );
+						mSynchronized = false;
+					}
+				}
+			}
+			else if( !( mInterval & AUXInterval2T ) )	// not a data bit interval
+			{
+				if( mInterval & AUXInterval5T )	// potential STOP
+					CheckStop< Policy >();
+				else
+				{
+					ReportError( mSample, AUXErrorStopInterval );
+					mSynchronized = false;
+				}
+			}
+		}
+	}
+
+	EndBurst();
+	return true;
+}
+
+template< class Policy > void DisplayPortAUXDecoder::CheckStop()
+{
+	mSynchronized = false;
+	if( IsIdleFor( 4 * HalfPeriod< Policy >() - mConfig.mTError ) )	// check 2nd half of STOP symbol
+	{
+		mFrame.mStartingSampleInclusive = mFrame.mEndingSampleInclusive + 1;
+		mFrame.mEndingSampleInclusive = mSample + 4 * HalfPeriod< Policy >();
+		mFrame.mType = AUXStop;
+		AddMarker< Policy >( mFrame.mStartingSampleInclusive, AUXMarkerStop );
+		AddFrame();
+	}
+	else	// STOP error
+	{
+		ReportError( mSample, AUXErrorStopIdle );
+	}
+}
+
+DisplayPortAUXArrayEdgeSource::DisplayPortAUXArrayEdgeSource( const U64* edges, U64 edge_count, bool initially_high )
+:	mEdges( edges ),
+	mEdgeCount( edge_count ),
+	mIndex( 0 ),
+	mInitiallyHigh( initially_high )
+{
+
+}
+
+bool DisplayPortAUXArrayEdgeSource::IsInitiallyHigh()
+{
+	return mInitiallyHigh;
+}
+
+U32 DisplayPortAUXArrayEdgeSource::ReadEdges( U64* edges, U32 max_edges )
+{
+	U64 count = mEdgeCount - mIndex;
+	if( count > max_edges )
+		count = max_edges;
+
+	for( U32 i = 0; i < U32( count ); ++i )
+		edges[ i ] = mEdges[ mIndex + i ];
+	mIndex += count;
+	return U32( count );
+}
+
+bool DisplayPortAUXArrayEdgeSource::WouldAdvancingToAbsPositionCauseTransition( U64 sample_number )
+{
+	if( mIndex >= mEdgeCount )
+		return false;	// nothing follows the last edge, the line stays idle
+	return mEdges[ mIndex ] <= sample_number;
+}
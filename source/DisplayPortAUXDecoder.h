@@ -0,0 +1,184 @@
+#ifndef DISPLAYPORTAUX_DECODER
+#define DISPLAYPORTAUX_DECODER
+
+#include "DisplayPortAUXTypes.h"
+#include "DisplayPortAUXIntervalClassifier.h"
+#include "DisplayPortAUXCommitScheduler.h"
+#include "DisplayPortAUXTransaction.h"
+#include <chrono>
+#include <vector>
+
+// Manchester decoder for the DisplayPort AUX channel (SYNC, START, data bytes, STOP).
+// It doesn't depend on the AnalyzerSDK: edges come from a DisplayPortAUXEdgeSource and
+// frames/markers go to a DisplayPortAUXDecoderSink, so the same state machine runs inside
+// the analyzer's WorkerThread() and in a local harness over recorded edge arrays.
+// Other line codings derive from it and replace Decode()/ClassifyEdges(); edge buffering,
+// markers, frames, the transaction layer and commits are shared.
+// The decoder counts its own work and every error cause; the counters go to the statistics with
+// every commit.
+// After an error in a burst, nothing up to the end of that burst can be a SYNC. SkipToIdle() passes
+// over its remaining edges in the prefetched blocks, comparing distances only, and the SYNC hunt
+// starts again at the next idle gap.
+
+enum DisplayPortAUXMarkerType { AUXMarkerStart, AUXMarkerStop, AUXMarkerOne, AUXMarkerZero, AUXMarkerError };
+
+struct DisplayPortAUXMarker
+{
+	U64 mSample;
+	DisplayPortAUXMarkerType mType;
+};
+
+class DisplayPortAUXEdgeSource
+{
+public:
+	virtual ~DisplayPortAUXEdgeSource() {}
+
+	virtual bool IsInitiallyHigh() = 0;	// line level before the first edge
+
+	// Copies the next edges into edges[], at least one and at most max_edges; only the first one may block.
+	// Returns 0 when there is no more data.
+	virtual U32 ReadEdges( U64* edges, U32 max_edges ) = 0;
+
+	// Looks ahead from the last edge returned by ReadEdges().
+	virtual bool WouldAdvancingToAbsPositionCauseTransition( U64 sample_number ) = 0;
+
+	virtual U64 GetGlitchCount() { return 0; }	// pulses the source removed, see DisplayPortAUXDeglitchFilter
+};
+
+class DisplayPortAUXDecoderSink
+{
+public:
+	virtual ~DisplayPortAUXDecoderSink() {}
+
+	virtual void AddFrame( const DisplayPortAUXFrame& frame ) = 0;
+	virtual void AddMarkers( const DisplayPortAUXMarker* markers, U32 count ) = 0;	// in sample order, batched by the decoder
+	virtual void CommitPacket( U32 transaction ) = 0;	// the frames since the last packet form one burst, transaction 0 = none
+	virtual void CommitResults( U64 sample_number ) = 0;	// everything up to sample_number is final
+};
+
+struct DisplayPortAUXDecoderConfig
+{
+	U32 mSampleRateHz;
+	U32 mT;				// half bit period, samples
+	U32 mTError;		// allowed deviation of any interval, samples
+	bool mClockRecovery;	// classify with the clock recovered from every SYNC instead of mT/mTError (Manchester)
+	U32 mBitRate;		// bits/s
+	U32 mSyncBitsNum;	// minimum number of SYNC 0s before START
+	bool mInverted;
+	DisplayPortAUXMarkerDensity mMarkerDensity;
+	U32 mCommitFrames;		// commit at least every mCommitFrames frames...
+	U32 mCommitIntervalMs;	// ...or every mCommitIntervalMs milliseconds
+	DisplayPortAUXDpcdShadow* mDpcd;	// updated with the DPCD accesses, may be NULL
+	DisplayPortAUXEdidReassembler* mEdid;	// updated with the I2C-over-AUX transfers, may be NULL
+	DisplayPortAUXStatistics* mStatistics;	// updated with every request and reply, may be NULL
+};
+
+// The settings the Manchester loops branch on, as template arguments. Decode() picks the
+// instantiation once, so the per edge and per bit code has no setting dependent loads or branches:
+// the polarity of a one, which markers are kept and where the half period comes from.
+template< bool Inverted, DisplayPortAUXMarkerDensity Density, bool ClockRecovery >
+struct DisplayPortAUXDecodePolicy
+{
+	static const bool IsInverted = Inverted;
+	static const bool UsesClockRecovery = ClockRecovery;
+	static const U32 MarkerMask =	// 1 << DisplayPortAUXMarkerType for every type that is emitted
+		( Density == MarkersAllBits ) ? ( 1 << AUXMarkerStart ) | ( 1 << AUXMarkerStop ) | ( 1 << AUXMarkerOne ) | ( 1 << AUXMarkerZero ) | ( 1 << AUXMarkerError ) :
+		( Density == MarkersStartStopErrors ) ? ( 1 << AUXMarkerStart ) | ( 1 << AUXMarkerStop ) | ( 1 << AUXMarkerError ) : 0;
+};
+
+class DisplayPortAUXDecoder
+{
+public:
+	DisplayPortAUXDecoder( const DisplayPortAUXDecoderConfig& config, DisplayPortAUXEdgeSource* source, DisplayPortAUXDecoderSink* sink );
+	virtual ~DisplayPortAUXDecoder();
+
+	void Run();	// decodes until the source runs out of edges
+	const DisplayPortAUXDecoderCounters& GetCounters() const { return mCounters; }
+
+protected:
+	enum
+	{
+		EdgeBufferSize = 4096,
+		MarkerBufferSize = 1024,
+		ResyncIdleHalfBits = 8	// longer than any interval inside a burst (5T at most), so only a gap between bursts
+	};
+
+	// line coding specific part, Manchester here
+	virtual void Decode();
+	virtual void ClassifyEdges( U32 count );	// mDistances[ 0 .. count - 1 ] of a new block are ready
+
+	bool FillEdgeBuffer();
+	bool IsIdleFor( U32 num_samples );
+	bool SkipToIdle();
+	void AddMarker( U64 sample_number, DisplayPortAUXMarkerType marker_type );	// filtered by mMarkerMask
+	void StoreMarker( U64 sample_number, DisplayPortAUXMarkerType marker_type );	// unfiltered, both AddMarker()s end here
+	void ReportError( U64 sample_number, DisplayPortAUXDecodeError error );	// error marker, ends the burst's sync
+	void PublishCounters();
+	void FlushMarkers();
+	void AddFrame();
+	void CommitResults( U64 sample_number, bool force );
+	void EndBurst();
+
+	// Manchester state machine, one instantiation per DisplayPortAUXDecodePolicy
+	template< class Policy > void DecodeWith();
+	template< class Policy > bool Advance();
+	template< class Policy > U32 HalfPeriod() const { return Policy::UsesClockRecovery ? mRecovery.GetHalfPeriod() : mConfig.mT; }
+	template< class Policy > void AddMarker( U64 sample_number, DisplayPortAUXMarkerType marker_type );
+	template< class Policy > bool Synchronize();
+	template< class Policy > void ReportSync( U32 sync_count, U64 start_end );
+	template< class Policy > bool CollectData();
+	template< class Policy > void CheckStop();
+
+	DisplayPortAUXDecoderConfig mConfig;
+	DisplayPortAUXIntervalClassifier mClassifier;
+	DisplayPortAUXClockRecovery mRecovery;
+	DisplayPortAUXEdgeSource* mSource;
+	DisplayPortAUXDecoderSink* mSink;
+
+	// edges are prefetched a block at a time, the intervals between them are classified in one pass
+	std::vector< U64 > mEdges;
+	std::vector< U64 > mDistances;
+	std::vector< U8 > mIntervals;
+	U32 mEdgeCount;
+	U32 mEdgeIndex;
+
+	// markers are filtered by mMarkerDensity and handed to the sink in batches
+	U32 mMarkerMask;	// DisplayPortAUXDecodePolicy::MarkerMask of mMarkerDensity, for the code that isn't instantiated per policy
+	std::vector< DisplayPortAUXMarker > mMarkers;
+	U32 mMarkerCount;
+
+	DisplayPortAUXTransactionParser mTransactions;
+
+	DisplayPortAUXCommitScheduler mCommitScheduler;
+	U64 mPendingSample;	// end of the last frame that is not committed yet
+
+	DisplayPortAUXDecoderCounters mCounters;
+	std::chrono::steady_clock::time_point mRunStart;
+
+	U64 mSample;	// current edge
+	U8 mInterval;	// DisplayPortAUXInterval mask of the distance from the previous edge
+	bool mHigh;		// line level after the current edge
+	bool mSynchronized;
+	bool mSkipToIdle;	// an error broke the burst, the rest of it is skipped before hunting for SYNC
+	U64 mPacketNum;
+	DisplayPortAUXFrame mFrame;
+};
+
+// Edge source over an in-memory array of edge timestamps, e.g. a recorded capture.
+class DisplayPortAUXArrayEdgeSource : public DisplayPortAUXEdgeSource
+{
+public:
+	DisplayPortAUXArrayEdgeSource( const U64* edges, U64 edge_count, bool initially_high );
+
+	virtual bool IsInitiallyHigh();
+	virtual U32 ReadEdges( U64* edges, U32 max_edges );
+	virtual bool WouldAdvancingToAbsPositionCauseTransition( U64 sample_number );
+
+protected:
+	const U64* mEdges;
+	U64 mEdgeCount;
+	U64 mIndex;
+	bool mInitiallyHigh;
+};
+
+#endif //DISPLAYPORTAUX_DECODER
@@ -0,0 +1,97 @@
+#include "DisplayPortAUXDeglitchFilter.h"
+
+DisplayPortAUXDeglitchFilter::DisplayPortAUXDeglitchFilter( DisplayPortAUXEdgeSource* source, U64 min_width )
+:	mSource( source ),
+	mMinWidth( min_width ),
+	mGlitches( 0 ),
+	mLastEdge( 0 ),
+	mNext( 0 ),
+	mReady( 0 ),
+	mBlock( BlockSize )
+{
+
+}
+
+bool DisplayPortAUXDeglitchFilter::IsInitiallyHigh()
+{
+	return mSource->IsInitiallyHigh();
+}
+
+U32 DisplayPortAUXDeglitchFilter::ReadEdges( U64* edges, U32 max_edges )
+{
+	while( mNext == mReady )
+		if( Fill() == false )
+			return 0;
+
+	size_t count = mReady - mNext;
+	if( count > max_edges )
+		count = max_edges;
+	for( size_t i = 0; i < count; ++i )
+		edges[ i ] = mEdges[ mNext + i ];
+	mNext += count;
+	return U32( count );
+}
+
+bool DisplayPortAUXDeglitchFilter::WouldAdvancingToAbsPositionCauseTransition( U64 sample_number )
+{
+	if( mNext < mEdges.size() )
+		return mEdges[ mNext ] <= sample_number;
+	return mSource->WouldAdvancingToAbsPositionCauseTransition( sample_number );	// may count a glitch that isn't filtered yet
+}
+
+bool DisplayPortAUXDeglitchFilter::Fill()
+{
+	// only the open cluster is left once everything final is handed out
+	mEdges.erase( mEdges.begin(), mEdges.begin() + mNext );
+	mReady -= mNext;
+	mNext = 0;
+
+	U32 count = mSource->ReadEdges( &mBlock[ 0 ], BlockSize );
+	if( count == 0 )
+	{
+		ResolveCluster();	// no more data, the last cluster is complete
+		return mReady != 0;
+	}
+
+	for( U32 i = 0; i < count; ++i )
+	{
+		U64 edge = mBlock[ i ];
+		if( ( mEdges.size() > mReady ) && ( ( edge - mLastEdge >= mMinWidth ) || ( mEdges.size() - mReady >= U32( MaxCluster ) ) ) )
+			ResolveCluster();
+		mEdges.push_back( edge );
+		mLastEdge = edge;
+	}
+
+	// caught up with the captured data: if the line stays quiet long enough after the last edge, the
+	// cluster is complete
+	if( ( count < U32( BlockSize ) ) && ( mReady < mEdges.size() ) && ( mSource->WouldAdvancingToAbsPositionCauseTransition( mLastEdge + mMinWidth - 1 ) == false ) )
+		ResolveCluster();
+	return true;
+}
+
+void DisplayPortAUXDeglitchFilter::ResolveCluster()
+{
+	// narrowest pulse first: a glitch in a short run leaves two narrow pieces of the run, removing the
+	// glitch joins them again. Of equally narrow pulses the one farther from the cluster's first edge
+	// goes, that edge is the real one when the glitch follows it.
+	for( ; ; )
+	{
+		size_t narrowest = 0;
+		U64 width = mMinWidth;
+		for( size_t i = mReady + 1; i < mEdges.size(); ++i )
+		{
+			U64 pulse = mEdges[ i ] - mEdges[ i - 1 ];
+			if( ( pulse < width ) || ( ( pulse == width ) && ( narrowest != 0 ) ) )
+			{
+				width = pulse;
+				narrowest = i;
+			}
+		}
+		if( narrowest == 0 )
+			break;
+
+		mEdges.erase( mEdges.begin() + ( narrowest - 1 ), mEdges.begin() + ( narrowest + 1 ) );
+		++mGlitches;
+	}
+	mReady = mEdges.size();
+}
@@ -0,0 +1,50 @@
+#ifndef DISPLAYPORTAUX_DEGLITCH_FILTER
+#define DISPLAYPORTAUX_DEGLITCH_FILTER
+
+#include "DisplayPortAUXDecoder.h"
+
+// Removes glitches from the edges before the decoder classifies them.
+// A pulse narrower than min_width samples can't be part of the line code. Edges closer than that to
+// the edge before form a cluster; within a cluster the narrowest pulse is removed (both its edges,
+// the line keeps its level across it, of two equally narrow ones the later) until no pulse is too
+// narrow any more. A glitch on a quiet line disappears, a glitch right after a real edge (ringing, a
+// slow edge crossing the threshold twice) leaves the real edge where it was, and a glitch in a
+// short run doesn't take the edges of the run with it.
+// An edge is only handed on once its cluster is complete. The filter works on the blocks the source
+// returns anyway and holds back the open cluster at the end of a block; when it has caught up with
+// the captured data, one look ahead per block decides whether that cluster is complete. No SDK call
+// is added per edge.
+
+class DisplayPortAUXDeglitchFilter : public DisplayPortAUXEdgeSource
+{
+public:
+	enum
+	{
+		BlockSize = 4096,
+		MaxCluster = 256	// a longer one (noise, not a signal) is resolved in pieces
+	};
+
+	DisplayPortAUXDeglitchFilter( DisplayPortAUXEdgeSource* source, U64 min_width );
+
+	virtual bool IsInitiallyHigh();
+	virtual U32 ReadEdges( U64* edges, U32 max_edges );
+	virtual bool WouldAdvancingToAbsPositionCauseTransition( U64 sample_number );
+	virtual U64 GetGlitchCount() { return mGlitches; }
+
+protected:
+	bool Fill();
+	void ResolveCluster();	// the edges from mReady on, they are final afterwards
+
+	DisplayPortAUXEdgeSource* mSource;
+	U64 mMinWidth;
+	U64 mGlitches;
+	U64 mLastEdge;	// the last one read from the source
+
+	// edges that passed the filter: final ones from mNext to mReady, then the open cluster
+	std::vector< U64 > mEdges;
+	size_t mNext;
+	size_t mReady;
+	std::vector< U64 > mBlock;
+};
+
+#endif //DISPLAYPORTAUX_DEGLITCH_FILTER
@@ -0,0 +1,169 @@
+#include "DisplayPortAUXDpcd.h"
+#include <algorithm>
+
+struct DisplayPortAUXDpcdRegister
+{
+	U32 mAddress;
+	const char* mName;
+};
+
+static const DisplayPortAUXDpcdRegister gRegisters[] =	// sorted by address
+{
+	{ 0x00000, "DPCD_REV" },
+	{ 0x00001, "MAX_LINK_RATE" },
+	{ 0x00002, "MAX_LANE_COUNT" },
+	{ 0x00003, "MAX_DOWNSPREAD" },
+	{ 0x00004, "NORP" },
+	{ 0x00005, "DOWN_STREAM_PORT_PRESENT" },
+	{ 0x00006, "MAIN_LINK_CHANNEL_CODING" },
+	{ 0x00007, "DOWN_STREAM_PORT_COUNT" },
+	{ 0x00008, "RECEIVE_PORT0_CAP_0" },
+	{ 0x00009, "RECEIVE_PORT0_CAP_1" },
+	{ 0x0000E, "TRAINING_AUX_RD_INTERVAL" },
+	{ 0x00021, "MSTM_CAP" },
+	{ 0x00060, "DSC_SUPPORT" },
+	{ 0x00100, "LINK_BW_SET" },
+	{ 0x00101, "LANE_COUNT_SET" },
+	{ 0x00102, "TRAINING_PATTERN_SET" },
+	{ 0x00103, "TRAINING_LANE0_SET" },
+	{ 0x00104, "TRAINING_LANE1_SET" },
+	{ 0x00105, "TRAINING_LANE2_SET" },
+	{ 0x00106, "TRAINING_LANE3_SET" },
+	{ 0x00107, "DOWNSPREAD_CTRL" },
+	{ 0x00108, "MAIN_LINK_CHANNEL_CODING_SET" },
+	{ 0x00111, "MSTM_CTRL" },
+	{ 0x00200, "SINK_COUNT" },
+	{ 0x00201, "DEVICE_SERVICE_IRQ_VECTOR" },
+	{ 0x00202, "LANE0_1_STATUS" },
+	{ 0x00203, "LANE2_3_STATUS" },
+	{ 0x00204, "LANE_ALIGN_STATUS_UPDATED" },
+	{ 0x00205, "SINK_STATUS" },
+	{ 0x00206, "ADJUST_REQUEST_LANE0_1" },
+	{ 0x00207, "ADJUST_REQUEST_LANE2_3" },
+	{ 0x00218, "TEST_REQUEST" },
+	{ 0x00260, "TEST_RESPONSE" },
+	{ 0x00270, "TEST_SINK" },
+	{ 0x00600, "SET_POWER" },
+	{ 0x02002, "SINK_COUNT_ESI" },
+	{ 0x02003, "DEVICE_SERVICE_IRQ_VECTOR_ESI0" },
+	{ 0x0200C, "LANE0_1_STATUS_ESI" },
+	{ 0x0200D, "LANE2_3_STATUS_ESI" },
+	{ 0x0200E, "LANE_ALIGN_STATUS_UPDATED_ESI" },
+	{ 0x0200F, "SINK_STATUS_ESI" },
+	{ 0x02200, "EXTENDED_DPCD_REV" },
+	{ 0x68000, "HDCP_BKSV" },
+	{ 0x68028, "HDCP_BCAPS" },
+	{ 0x68029, "HDCP_BSTATUS" }
+};
+
+DisplayPortAUXDpcdShadow::DisplayPortAUXDpcdShadow()
+{
+	Clear();
+}
+
+void DisplayPortAUXDpcdShadow::Clear()
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	mPages.assign( NumPages, std::shared_ptr< Page >() );
+	mLog.clear();
+	mSnapshots.clear();
+
+	Snapshot empty;
+	empty.mLogIndex = 0;
+	empty.mPages = mPages;
+	mSnapshots.push_back( empty );
+}
+
+void DisplayPortAUXDpcdShadow::Write( U64 sample_number, U32 address, const U8* data, U32 count )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	for( U32 i = 0; i < count; ++i )
+	{
+		U32 byte_address = ( address + i ) & ( ( 1 << AddressBits ) - 1 );
+		std::shared_ptr< Page >& page = mPages[ byte_address >> PageBits ];
+		U32 offset = byte_address & ( PageSize - 1 );
+		U8 known_bit = U8( 1 << ( offset & 7 ) );
+
+		if( ( page ) && ( page->mKnown[ offset >> 3 ] & known_bit ) && ( page->mData[ offset ] == data[ i ] ) )
+			continue;	// no change
+
+		if( !page )
+		{
+			page.reset( new Page() );
+		}
+		else if( page.use_count() > 1 )
+		{
+			page.reset( new Page( *page ) );	// shared with a snapshot
+		}
+		page->mData[ offset ] = data[ i ];
+		page->mKnown[ offset >> 3 ] |= known_bit;
+
+		DisplayPortAUXDpcdChange change;
+		change.mSampleNumber = sample_number;
+		change.mAddress = byte_address;
+		change.mValue = data[ i ];
+		mLog.push_back( change );
+	}
+
+	if( mLog.size() - mSnapshots.back().mLogIndex >= SnapshotInterval )
+	{
+		Snapshot snapshot;
+		snapshot.mLogIndex = mLog.size();
+		snapshot.mPages = mPages;
+		mSnapshots.push_back( snapshot );
+	}
+}
+
+bool DisplayPortAUXDpcdShadow::GetValueAt( U32 address, U64 sample_number, U8& value )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	// changes up to sample_number, the log is in sample order
+	U64 end = std::upper_bound( mLog.begin(), mLog.end(), sample_number,
+		[]( U64 sample, const DisplayPortAUXDpcdChange& change ) { return sample < change.mSampleNumber; } ) - mLog.begin();
+
+	// newest snapshot that doesn't include later changes
+	const Snapshot& snapshot = *( std::upper_bound( mSnapshots.begin(), mSnapshots.end(), end,
+		[]( U64 log_index, const Snapshot& s ) { return log_index < s.mLogIndex; } ) - 1 );
+
+	for( U64 i = end; i > snapshot.mLogIndex; --i )
+	{
+		if( mLog[ i - 1 ].mAddress == address )
+		{
+			value = mLog[ i - 1 ].mValue;
+			return true;
+		}
+	}
+
+	const Page* page = snapshot.mPages[ address >> PageBits ].get();
+	U32 offset = address & ( PageSize - 1 );
+	if( ( page == NULL ) || ( ( page->mKnown[ offset >> 3 ] & ( 1 << ( offset & 7 ) ) ) == 0 ) )
+		return false;
+
+	value = page->mData[ offset ];
+	return true;
+}
+
+U64 DisplayPortAUXDpcdShadow::GetNumChanges()
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+	return mLog.size();
+}
+
+DisplayPortAUXDpcdChange DisplayPortAUXDpcdShadow::GetChange( U64 index )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+	return mLog[ index ];
+}
+
+const char* DisplayPortAUXDpcdShadow::GetRegisterName( U32 address )
+{
+	const DisplayPortAUXDpcdRegister* end = gRegisters + sizeof( gRegisters ) / sizeof( gRegisters[ 0 ] );
+	const DisplayPortAUXDpcdRegister* reg = std::lower_bound( gRegisters, end, address,
+		[]( const DisplayPortAUXDpcdRegister& r, U32 a ) { return r.mAddress < a; } );
+	if( ( reg == end ) || ( reg->mAddress != address ) )
+		return NULL;
+	return reg->mName;
+}
@@ -0,0 +1,59 @@
+#ifndef DISPLAYPORTAUX_DPCD
+#define DISPLAYPORTAUX_DPCD
+
+#include "DisplayPortAUXTypes.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Shadow of the sink's DPCD register space, fed with acknowledged native writes and read replies.
+// The 1MB (20 bit) address space is kept in 256 byte pages that are allocated on first access.
+// Every change is logged; every SnapshotInterval changes the page table is copied. Snapshots share
+// the pages with the current state and a page is only cloned when it changes again (copy-on-write),
+// so "value at sample S" is a snapshot lookup plus a scan of at most SnapshotInterval log entries.
+// Written by the decoder thread, read by the UI and export threads.
+
+struct DisplayPortAUXDpcdChange
+{
+	U64 mSampleNumber;
+	U32 mAddress;
+	U8 mValue;
+};
+
+class DisplayPortAUXDpcdShadow
+{
+public:
+	DisplayPortAUXDpcdShadow();
+
+	void Clear();
+	void Write( U64 sample_number, U32 address, const U8* data, U32 count );
+
+	bool GetValueAt( U32 address, U64 sample_number, U8& value );	// false if the register wasn't accessed yet
+	U64 GetNumChanges();
+	DisplayPortAUXDpcdChange GetChange( U64 index );
+
+	static const char* GetRegisterName( U32 address );	// NULL if unknown
+
+protected:
+	enum { AddressBits = 20, PageBits = 8, PageSize = 1 << PageBits, NumPages = 1 << ( AddressBits - PageBits ), SnapshotInterval = 4096 };
+
+	struct Page
+	{
+		U8 mData[ PageSize ];
+		U8 mKnown[ PageSize / 8 ];
+	};
+	typedef std::vector< std::shared_ptr< Page > > PageTable;
+
+	struct Snapshot
+	{
+		U64 mLogIndex;	// state after mLog[ 0 .. mLogIndex - 1 ]
+		PageTable mPages;
+	};
+
+	std::mutex mMutex;
+	PageTable mPages;
+	std::vector< DisplayPortAUXDpcdChange > mLog;
+	std::vector< Snapshot > mSnapshots;
+};
+
+#endif //DISPLAYPORTAUX_DPCD
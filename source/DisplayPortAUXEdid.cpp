@@ -0,0 +1,116 @@
+#include "DisplayPortAUXEdid.h"
+#include <string.h>
+
+DisplayPortAUXEdidReassembler::DisplayPortAUXEdidReassembler()
+{
+	Clear();
+}
+
+void DisplayPortAUXEdidReassembler::Clear()
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	mSegment = 0;
+	mOffset = 0;
+	mStagingIndex = 0;
+	memset( mReceived, 0, sizeof( mReceived ) );
+	mReceivedCount = 0;
+	mBlocks.clear();
+}
+
+DisplayPortAUXEdidStatus DisplayPortAUXEdidReassembler::AddTransfer( U64 sample_number, U32 address, bool read, bool stop, const U8* data, U32 count, U32& block_index )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	DisplayPortAUXEdidStatus status = AUXEdidNone;
+	if( ( read == false ) && ( count != 0 ) )
+	{
+		if( address == SegmentPointerAddress )
+			mSegment = data[ 0 ];
+		else if( address == EdidAddress )
+			mOffset = data[ 0 ];
+	}
+	else if( ( read == true ) && ( address == EdidAddress ) )
+	{
+		for( U32 i = 0; i < count; ++i )
+		{
+			U32 index = ( U32( mSegment ) << 1 ) | ( mOffset >> 7 );
+			U32 offset = mOffset & ( BlockSize - 1 );
+			++mOffset;	// wraps within the segment
+
+			if( index != mStagingIndex )
+			{
+				mStagingIndex = index;
+				memset( mReceived, 0, sizeof( mReceived ) );
+				mReceivedCount = 0;
+			}
+
+			mStaging[ offset ] = data[ i ];
+			if( ( mReceived[ offset >> 3 ] & ( 1 << ( offset & 7 ) ) ) == 0 )
+			{
+				mReceived[ offset >> 3 ] |= U8( 1 << ( offset & 7 ) );
+				++mReceivedCount;
+			}
+
+			if( mReceivedCount == BlockSize )
+			{
+				DisplayPortAUXEdidBlock block;
+				block.mSampleNumber = sample_number;
+				block.mIndex = index;
+				memcpy( block.mData, mStaging, BlockSize );
+
+				U8 checksum = 0;
+				for( U32 k = 0; k < BlockSize; ++k )
+					checksum += mStaging[ k ];
+				block.mChecksumOk = ( checksum == 0 );
+				mBlocks.push_back( block );
+
+				memset( mReceived, 0, sizeof( mReceived ) );
+				mReceivedCount = 0;
+
+				block_index = index;
+				status = ( block.mChecksumOk == true ) ? AUXEdidBlockOk : AUXEdidChecksumError;
+			}
+		}
+	}
+
+	if( stop == true )
+		mSegment = 0;
+
+	return status;
+}
+
+U32 DisplayPortAUXEdidReassembler::GetNumBlocks()
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+	return U32( mBlocks.size() );
+}
+
+DisplayPortAUXEdidBlock DisplayPortAUXEdidReassembler::GetBlock( U32 index )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+	return mBlocks[ index ];
+}
+
+void DisplayPortAUXEdidReassembler::GetEdid( std::vector< U8 >& edid )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	edid.clear();
+	for( U32 index = 0; ; ++index )
+	{
+		const DisplayPortAUXEdidBlock* newest = NULL;
+		for( size_t i = mBlocks.size(); i > 0; --i )
+		{
+			if( mBlocks[ i - 1 ].mIndex == index )
+			{
+				newest = &mBlocks[ i - 1 ];
+				break;
+			}
+		}
+		if( newest == NULL )
+			return;
+
+		edid.insert( edid.end(), newest->mData, newest->mData + BlockSize );
+	}
+}
@@ -0,0 +1,59 @@
+#ifndef DISPLAYPORTAUX_EDID
+#define DISPLAYPORTAUX_EDID
+
+#include "DisplayPortAUXTypes.h"
+#include <mutex>
+#include <vector>
+
+// Rebuilds EDID blocks from acknowledged I2C-over-AUX transfers (E-DDC):
+//   write 0x30 = segment pointer, write 0x50 = word offset, read 0x50 = EDID bytes (offset auto-increments).
+// The segment pointer is cleared by the I2C STOP, i.e. after a transfer without MOT.
+// A block is done when all of its 128 bytes were read; the checksum is validated right away.
+// Written by the decoder thread, read by the UI and export threads.
+
+enum DisplayPortAUXEdidStatus
+{
+	AUXEdidNone,
+	AUXEdidBlockOk,
+	AUXEdidChecksumError
+};
+
+struct DisplayPortAUXEdidBlock
+{
+	U64 mSampleNumber;	// when the last byte was read
+	U32 mIndex;			// segment * 2 + block in segment
+	bool mChecksumOk;
+	U8 mData[ 128 ];
+};
+
+class DisplayPortAUXEdidReassembler
+{
+public:
+	enum { BlockSize = 128, SegmentPointerAddress = 0x30, EdidAddress = 0x50 };
+
+	DisplayPortAUXEdidReassembler();
+
+	void Clear();
+
+	// read is false for writes; stop is true for the last transfer of an I2C transaction (no MOT)
+	DisplayPortAUXEdidStatus AddTransfer( U64 sample_number, U32 address, bool read, bool stop, const U8* data, U32 count, U32& block_index );
+
+	U32 GetNumBlocks();
+	DisplayPortAUXEdidBlock GetBlock( U32 index );
+	void GetEdid( std::vector< U8 >& edid );	// newest copy of blocks 0, 1, ... up to the first missing one
+
+protected:
+	std::mutex mMutex;
+
+	U8 mSegment;
+	U8 mOffset;
+
+	U32 mStagingIndex;
+	U8 mStaging[ BlockSize ];
+	U8 mReceived[ BlockSize / 8 ];
+	U32 mReceivedCount;
+
+	std::vector< DisplayPortAUXEdidBlock > mBlocks;	// in the order they were completed
+};
+
+#endif //DISPLAYPORTAUX_EDID
@@ -0,0 +1,187 @@
+#include "DisplayPortAUXExportWriter.h"
+#include <string.h>
+
+static const char gHexDigits[] = "0123456789ABCDEF";
+static const char gDigitPairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+DisplayPortAUXExportWriter::DisplayPortAUXExportWriter()
+:	mToFile( false ),
+	mFile( NULL ),
+	mBuffer( MaxFieldLength ),
+	mUsed( 0 )
+{
+
+}
+
+DisplayPortAUXExportWriter::DisplayPortAUXExportWriter( const char* file, U32 buffer_size )
+:	mToFile( true ),
+	mFile( AnalyzerHelpers::StartFile( file ) ),
+	mBuffer( ( buffer_size < U32( MaxFieldLength ) ) ? U32( MaxFieldLength ) : buffer_size ),
+	mUsed( 0 )
+{
+
+}
+
+DisplayPortAUXExportWriter::~DisplayPortAUXExportWriter()
+{
+	Close();
+}
+
+void DisplayPortAUXExportWriter::Append( const char* str )
+{
+	Append( str, U32( strlen( str ) ) );
+}
+
+void DisplayPortAUXExportWriter::Append( const void* data, U32 length )
+{
+	if( ( length > mBuffer.size() ) && ( mToFile == true ) )
+	{
+		Flush();
+		if( mFile != NULL )
+			AnalyzerHelpers::AppendToFile( ( U8* )data, length, mFile );
+		return;
+	}
+
+	Reserve( length );
+	memcpy( &mBuffer[ mUsed ], data, length );
+	mUsed += length;
+}
+
+void DisplayPortAUXExportWriter::AppendHex( U64 value, U32 digits )
+{
+	if( digits > 16 )
+		digits = 16;
+
+	Reserve( digits );
+	char* out = &mBuffer[ mUsed ];
+	for( U32 i = digits; i > 0; --i )
+	{
+		out[ i - 1 ] = gHexDigits[ value & 0xF ];
+		value >>= 4;
+	}
+	mUsed += digits;
+}
+
+void DisplayPortAUXExportWriter::AppendDecimal( U64 value )
+{
+	// digits are produced from the right, two at a time
+	char digits[ 20 ];
+	U32 pos = sizeof( digits );
+
+	while( value >= 100 )
+	{
+		U32 pair = U32( value % 100 ) * 2;
+		value /= 100;
+		digits[ --pos ] = gDigitPairs[ pair + 1 ];
+		digits[ --pos ] = gDigitPairs[ pair ];
+	}
+	if( value >= 10 )
+	{
+		U32 pair = U32( value ) * 2;
+		digits[ --pos ] = gDigitPairs[ pair + 1 ];
+		digits[ --pos ] = gDigitPairs[ pair ];
+	}
+	else
+	{
+		digits[ --pos ] = char( '0' + value );
+	}
+
+	Append( digits + pos, sizeof( digits ) - pos );
+}
+
+void DisplayPortAUXExportWriter::AppendNumber( U64 value, DisplayBase display_base, U32 num_bits )
+{
+	switch( display_base )
+	{
+	case Decimal:
+		AppendDecimal( value );
+		break;
+	case Hexadecimal:
+		AppendChar( '0' );
+		AppendChar( 'x' );
+		AppendHex( value, ( num_bits + 3 ) / 4 );
+		break;
+	default:
+		{
+			char number_str[ MaxFieldLength ];
+			AnalyzerHelpers::GetNumberString( value, display_base, num_bits, number_str, MaxFieldLength );
+			Append( number_str );
+		}
+		break;
+	}
+}
+
+void DisplayPortAUXExportWriter::AppendTime( U64 sample, U64 trigger_sample, U32 sample_rate_hz )
+{
+	// fixed point: whole seconds, then the remainder scaled to nanoseconds and rounded
+	const U64 nanoseconds_per_second = 1000000000ULL;
+	U64 rate = ( sample_rate_hz != 0 ) ? sample_rate_hz : 1;
+	bool negative = sample < trigger_sample;
+	U64 distance = ( negative == true ) ? trigger_sample - sample : sample - trigger_sample;
+
+	U64 seconds = distance / rate;
+	U64 fraction = ( ( distance % rate ) * nanoseconds_per_second + rate / 2 ) / rate;	// remainder < 2^32, fits in 64 bits
+	if( fraction == nanoseconds_per_second )
+	{
+		++seconds;
+		fraction = 0;
+	}
+
+	if( negative == true )
+		AppendChar( '-' );
+	AppendDecimal( seconds );
+	AppendChar( '.' );
+
+	Reserve( 9 );
+	char* out = &mBuffer[ mUsed ];
+	for( U32 i = 9; i > 0; --i )
+	{
+		out[ i - 1 ] = char( '0' + fraction % 10 );
+		fraction /= 10;
+	}
+	mUsed += 9;
+}
+
+void DisplayPortAUXExportWriter::MakeRoom( U32 length )
+{
+	if( mToFile == true )
+	{
+		Flush();
+		return;
+	}
+
+	size_t size = mBuffer.size();
+	while( size < mUsed + length )
+		size *= 2;
+	mBuffer.resize( size );
+}
+
+void DisplayPortAUXExportWriter::Flush()
+{
+	if( mToFile == false )
+		return;
+
+	if( ( mUsed != 0 ) && ( mFile != NULL ) )
+		AnalyzerHelpers::AppendToFile( ( U8* )&mBuffer[ 0 ], mUsed, mFile );
+	mUsed = 0;
+}
+
+void DisplayPortAUXExportWriter::Close()
+{
+	if( mFile == NULL )
+		return;
+
+	Flush();
+	AnalyzerHelpers::EndFile( mFile );
+	mFile = NULL;
+}
@@ -0,0 +1,50 @@
+#ifndef DISPLAYPORTAUX_EXPORT_WRITER
+#define DISPLAYPORTAUX_EXPORT_WRITER
+
+#include <AnalyzerHelpers.h>
+#include <vector>
+
+// Buffered writer for the export files. Text is formatted straight into one reusable buffer, which
+// goes to the file in multi-megabyte blocks, so an export is bound by the disk rather than by
+// string handling. The number formatters produce the same text as AnalyzerHelpers for Decimal and
+// Hexadecimal and fall back to it for the other display bases.
+// Without a file the writer only formats into memory and the buffer grows as needed; the parallel
+// export formats chunks that way and appends them to the file writer in order.
+
+class DisplayPortAUXExportWriter
+{
+public:
+	enum { DefaultBufferSize = 4 * 1024 * 1024, MaxFieldLength = 128 };
+
+	DisplayPortAUXExportWriter();	// memory only
+	DisplayPortAUXExportWriter( const char* file, U32 buffer_size = DefaultBufferSize );
+	~DisplayPortAUXExportWriter();
+
+	void Append( const char* str );
+	void Append( const void* data, U32 length );
+	void Append( const DisplayPortAUXExportWriter& other ) { if( other.mUsed != 0 ) Append( &other.mBuffer[ 0 ], other.mUsed ); }
+	void AppendChar( char c ) { Reserve( 1 ); mBuffer[ mUsed++ ] = c; }
+	void AppendNewLine() { AppendChar( '\n' ); }
+	void AppendHex( U64 value, U32 digits );	// upper case, zero padded to digits, no prefix
+	void AppendDecimal( U64 value );
+	void AppendNumber( U64 value, DisplayBase display_base, U32 num_bits );
+	void AppendTime( U64 sample, U64 trigger_sample, U32 sample_rate_hz );	// seconds, 9 decimals
+
+	U32 GetSize() const { return mUsed; }
+	const char* GetBuffer() const { return &mBuffer[ 0 ]; }	// memory only, the text formatted so far
+	void Clear() { mUsed = 0; }
+
+	void Flush();
+	void Close();
+
+protected:
+	void Reserve( U32 length ) { if( mUsed + length > mBuffer.size() ) MakeRoom( length ); }
+	void MakeRoom( U32 length );
+
+	bool mToFile;
+	void* mFile;
+	std::vector< char > mBuffer;
+	U32 mUsed;
+};
+
+#endif //DISPLAYPORTAUX_EXPORT_WRITER
@@ -0,0 +1,230 @@
+#include "DisplayPortAUXFauxDecoder.h"
+#include "DisplayPortAUXSimd.h"
+
+DisplayPortAUXFauxDecoder::DisplayPortAUXFauxDecoder( const DisplayPortAUXDecoderConfig& config, DisplayPortAUXEdgeSource* source, DisplayPortAUXDecoderSink* sink )
+:	DisplayPortAUXDecoder( config, source, sink ),
+	mRunBits( EdgeBufferSize ),
+	mShift( 0 ),
+	mValidBits( 0 ),
+	mSymbolBitCount( 0 ),
+	mSymbolStart( 0 ),
+	mState( FauxHunting ),
+	mCommaCount( 0 ),
+	mCommaStart( 0 ),
+	mCommaEnd( 0 )
+{
+	U32 bit_rate = ( mConfig.mBitRate != 0 ) ? mConfig.mBitRate : 1;
+	mBitPeriod = ( U64( mConfig.mSampleRateHz ) << 16 ) / bit_rate;
+	mBitsPerSample = float( double( bit_rate ) / double( mConfig.mSampleRateHz ) );
+	mIdleSamples = U32( ( U64( IdleRunBits ) * mBitPeriod ) >> 16 );
+}
+
+DisplayPortAUXFauxDecoder::~DisplayPortAUXFauxDecoder()
+{
+
+}
+
+void DisplayPortAUXFauxDecoder::Decode()
+{
+	mState = FauxHunting;
+	mShift = 0;
+	mValidBits = 0;
+	mSymbolBitCount = 0;
+
+	const bool inverted = mConfig.mInverted;	// read once, not reloaded after every call in the loop
+	while( FillEdgeBuffer() == true )
+	{
+		for( U32 i = 0; i < mEdgeCount; ++i )
+		{
+			bool level = ( mHigh != inverted );	// line level before this edge
+			U32 bits = mRunBits[ i ];
+			if( bits > MaxRunBits )
+				AddIdle( mEdges[ i ], level );
+			else
+				AddRun( S64( mEdges[ i ] - mDistances[ i ] ), bits, level );
+			mHigh = !mHigh;
+		}
+
+		mSample = mEdges[ mEdgeCount - 1 ];
+		mEdgeIndex = mEdgeCount;
+	}
+}
+
+void DisplayPortAUXFauxDecoder::ClassifyEdges( U32 count )
+{
+	// bits = round( min( distance, mIdleSamples ) * mBitsPerSample )
+	const U64* distances = &mDistances[ 0 ];
+	U8* runs = &mRunBits[ 0 ];
+	U32 i = 0;
+
+#ifdef DISPLAYPORTAUX_SSE2
+	// 4 distances per iteration, saturated to 32 bits and clamped with sign-flipped signed compares
+	const __m128i sign = _mm_set1_epi32( S32( 0x80000000 ) );
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i idle = _mm_set1_epi32( S32( mIdleSamples ) );
+	const __m128i idle_flipped = _mm_xor_si128( idle, sign );
+	const __m128 scale = _mm_set1_ps( mBitsPerSample );
+	const __m128 half = _mm_set1_ps( 0.5f );
+
+	for( ; i + 4 <= count; i += 4 )
+	{
+		__m128 a = _mm_castsi128_ps( _mm_loadu_si128( ( const __m128i* )( distances + i ) ) );
+		__m128 b = _mm_castsi128_ps( _mm_loadu_si128( ( const __m128i* )( distances + i + 2 ) ) );
+		__m128i low = _mm_castps_si128( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+		__m128i high = _mm_castps_si128( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+		__m128i fits = _mm_cmpeq_epi32( high, zero );
+		__m128i value = _mm_or_si128( low, _mm_andnot_si128( fits, _mm_cmpeq_epi32( zero, zero ) ) );
+
+		__m128i too_long = _mm_cmpgt_epi32( _mm_xor_si128( value, sign ), idle_flipped );
+		value = _mm_or_si128( _mm_and_si128( too_long, idle ), _mm_andnot_si128( too_long, value ) );
+
+		__m128 bits = _mm_add_ps( _mm_mul_ps( _mm_cvtepi32_ps( value ), scale ), half );
+		__m128i result = _mm_cvttps_epi32( bits );
+		result = _mm_packus_epi16( _mm_packs_epi32( result, zero ), zero );
+		U32 packed = U32( _mm_cvtsi128_si32( result ) );
+		runs[ i + 0 ] = U8( packed );
+		runs[ i + 1 ] = U8( packed >> 8 );
+		runs[ i + 2 ] = U8( packed >> 16 );
+		runs[ i + 3 ] = U8( packed >> 24 );
+	}
+#endif
+
+	for( ; i < count; ++i )
+	{
+		U32 distance = ( distances[ i ] > mIdleSamples ) ? mIdleSamples : U32( distances[ i ] );
+		runs[ i ] = U8( S32( float( S32( distance ) ) * mBitsPerSample + 0.5f ) );
+	}
+}
+
+void DisplayPortAUXFauxDecoder::AddRun( S64 start_sample, U32 bits, bool level )
+{
+	if( bits == 0 )
+		return;	// glitch shorter than half a bit
+
+	mShift = ( mShift << bits ) | ( ( level == true ) ? ( ( 1 << bits ) - 1 ) : 0 );
+	mValidBits = ( mValidBits + bits < 32 ) ? mValidBits + bits : 32;
+
+	if( mState == FauxHunting )
+	{
+		// a comma may end at any of the new bits, oldest first
+		for( S32 j = S32( bits ) - 1; j >= 0; --j )
+		{
+			if( ( S32( mValidBits ) - j >= S32( SymbolBits ) ) && ( DisplayPortAUX8b10b::Decode( mShift >> j ) == DisplayPortAUX8b10b::K28_5 ) )
+			{
+				mState = FauxPreamble;
+				mCommaCount = 0;
+				mSymbolBitCount = j;
+				mSymbolStart = start_sample + BitsToSamples( bits - j );
+				AddSymbol( DisplayPortAUX8b10b::K28_5, start_sample + BitsToSamples( S32( bits ) - j - SymbolBits ) );
+				return;
+			}
+		}
+		return;
+	}
+
+	mSymbolBitCount += bits;
+	if( mSymbolBitCount >= SymbolBits )	// runs are shorter than a symbol, at most one completes
+	{
+		mSymbolBitCount -= SymbolBits;
+		S64 symbol_start = mSymbolStart;
+		mSymbolStart = start_sample + BitsToSamples( bits - mSymbolBitCount );
+		AddSymbol( DisplayPortAUX8b10b::Decode( mShift >> mSymbolBitCount ), symbol_start );
+	}
+}
+
+void DisplayPortAUXFauxDecoder::AddIdle( U64 end_sample, bool level )
+{
+	if( ( mState != FauxHunting ) && ( mSymbolBitCount != 0 ) )	// the last symbol may end at the idle level
+		AddRun( mSymbolStart + BitsToSamples( mSymbolBitCount ), SymbolBits - mSymbolBitCount, level );
+
+	if( mState != FauxHunting )
+		SymbolError( mSymbolStart, AUXErrorFauxNoStop );	// no STOP before the line went idle
+
+	// the first comma of the next preamble may start at the idle level
+	mShift = 0;
+	mValidBits = 0;
+	AddRun( S64( end_sample ) - BitsToSamples( SymbolBits - 1 ), SymbolBits - 1, level );
+}
+
+void DisplayPortAUXFauxDecoder::AddSymbol( U16 symbol, S64 start_sample )
+{
+	S64 end_sample = start_sample + BitsToSamples( SymbolBits ) - 1;
+
+	if( mState == FauxPreamble )
+	{
+		if( symbol == DisplayPortAUX8b10b::K28_5 )
+		{
+			if( mCommaCount++ == 0 )
+				mCommaStart = start_sample;
+			mCommaEnd = end_sample;
+		}
+		else if( symbol == DisplayPortAUX8b10b::K27_7 )
+		{
+			// report SYNC frame
+			mFrame.mStartingSampleInclusive = mCommaStart;
+			mFrame.mEndingSampleInclusive = mCommaEnd;
+			mFrame.mData1 = mCommaCount;
+			mFrame.mData2 = ( U64( mConfig.mSampleRateHz ) * SymbolBits * mCommaCount ) / U64( mCommaEnd - mCommaStart + 1 );
+			mFrame.mType = AUXSync;
+			mFrame.mFlags = 0;
+			AddFrame();
+
+			// report START symbol
+			mFrame.mStartingSampleInclusive = start_sample;
+			mFrame.mEndingSampleInclusive = end_sample;
+			mFrame.mData1 = ++mPacketNum;
+			mFrame.mType = AUXStart;
+			AddMarker( start_sample, AUXMarkerStart );
+			AddFrame();
+
+			CommitResults( end_sample, false );
+			mState = FauxData;
+		}
+		else
+		{
+			SymbolError( start_sample, ( symbol == DisplayPortAUX8b10b::Invalid ) ? AUXErrorFauxInvalidCode : AUXErrorFauxUnexpectedSymbol );
+		}
+	}
+	else if( mState == FauxData )
+	{
+		if( symbol < DisplayPortAUX8b10b::KFlag )
+		{
+			mFrame.mStartingSampleInclusive = start_sample;
+			mFrame.mEndingSampleInclusive = end_sample;
+			mFrame.mData1 = symbol;
+			mFrame.mData2 = 0;
+			mFrame.mType = AUXData;
+			mFrame.mFlags = 0;
+			AddFrame();
+			CommitResults( end_sample, false );
+		}
+		else if( symbol == DisplayPortAUX8b10b::K29_7 )
+		{
+			mFrame.mStartingSampleInclusive = start_sample;
+			mFrame.mEndingSampleInclusive = end_sample;
+			mFrame.mType = AUXStop;
+			AddMarker( start_sample, AUXMarkerStop );
+			AddFrame();
+			EndBurst();
+			mState = FauxHunting;
+		}
+		else
+		{
+			SymbolError( start_sample, ( symbol == DisplayPortAUX8b10b::Invalid ) ? AUXErrorFauxInvalidCode : AUXErrorFauxUnexpectedSymbol );
+		}
+	}
+}
+
+void DisplayPortAUXFauxDecoder::SymbolError( S64 sample_number, DisplayPortAUXDecodeError error )
+{
+	ReportError( sample_number, error );
+	EndBurst();
+	mState = FauxHunting;
+	mValidBits = 0;	// hunt for the next comma in new bits only
+}
+
+S64 DisplayPortAUXFauxDecoder::BitsToSamples( S32 bits ) const
+{
+	S64 samples = S64( bits ) * S64( mBitPeriod );
+	return ( samples >= 0 ) ? ( samples >> 16 ) : -( ( -samples ) >> 16 );
+}
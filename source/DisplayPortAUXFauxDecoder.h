@@ -0,0 +1,52 @@
+#ifndef DISPLAYPORTAUX_FAUX_DECODER
+#define DISPLAYPORTAUX_FAUX_DECODER
+
+#include "DisplayPortAUXDecoder.h"
+#include "DisplayPortAUX8b10b.h"
+
+// Fast AUX decoder: NRZ, 8b/10b coded, one bit per mBitRate period.
+// A burst is a preamble of K28.5 commas (used for symbol alignment), K27.7 (START), data symbols
+// and K29.7 (STOP), followed by an idle line. It produces the same SYNC/START/data/STOP frames as
+// the Manchester decoder, so the transaction layer and the exports work unchanged.
+//
+// Bit recovery works on whole edge blocks: ClassifyEdges() converts every edge distance into a run
+// length in bits in one pass (SSE2 when available). The symbol loop then only shifts runs into a
+// register; 8b/10b runs are at most 5 bits, so every run completes at most one symbol and symbols
+// are decoded with a single table lookup.
+
+class DisplayPortAUXFauxDecoder : public DisplayPortAUXDecoder
+{
+public:
+	DisplayPortAUXFauxDecoder( const DisplayPortAUXDecoderConfig& config, DisplayPortAUXEdgeSource* source, DisplayPortAUXDecoderSink* sink );
+	virtual ~DisplayPortAUXFauxDecoder();
+
+protected:
+	enum { SymbolBits = 10, MaxRunBits = 6, IdleRunBits = MaxRunBits + 2 };	// a longer run is an idle line
+	enum FauxState { FauxHunting, FauxPreamble, FauxData };
+
+	virtual void Decode();
+	virtual void ClassifyEdges( U32 count );
+
+	void AddRun( S64 start_sample, U32 bits, bool level );
+	void AddIdle( U64 end_sample, bool level );
+	void AddSymbol( U16 symbol, S64 start_sample );
+	void SymbolError( S64 sample_number, DisplayPortAUXDecodeError error );
+	S64 BitsToSamples( S32 bits ) const;
+
+	std::vector< U8 > mRunBits;	// run length in bits of every edge distance in the block
+	U64 mBitPeriod;		// samples, 16.16 fixed point
+	float mBitsPerSample;
+	U32 mIdleSamples;	// distances are clamped to this, it's always more than IdleRunBits bits
+
+	U32 mShift;			// received bits, newest in bit 0
+	U32 mValidBits;		// bits in mShift received since the line was idle
+	U32 mSymbolBitCount;	// bits of the current symbol in mShift, FauxPreamble/FauxData only
+	S64 mSymbolStart;
+	FauxState mState;
+
+	U32 mCommaCount;
+	S64 mCommaStart;
+	S64 mCommaEnd;
+};
+
+#endif //DISPLAYPORTAUX_FAUX_DECODER
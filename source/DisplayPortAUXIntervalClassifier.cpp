@@ -0,0 +1,184 @@
+#include "DisplayPortAUXIntervalClassifier.h"
+#include "DisplayPortAUXSimd.h"
+
+static const U32 gHalfPeriods[] = { 1, 2, 4, 5 };
+
+DisplayPortAUXIntervalClassifier::DisplayPortAUXIntervalClassifier()
+:	mTableSize( 0 )
+{
+	for( U32 i = 0; i < NumClasses; ++i )
+	{
+		mLower[ i ] = 0xFFFFFFFF;
+		mUpper[ i ] = 0;
+	}
+}
+
+void DisplayPortAUXIntervalClassifier::Init( U32 t, U32 t_error )
+{
+	// same U32 arithmetic as the original comparisons, a lower bound that wraps around never matches
+	U32 largest_upper = 0;
+	for( U32 i = 0; i < NumClasses; ++i )
+	{
+		mLower[ i ] = ( gHalfPeriods[ i ] * t ) - t_error;
+		mUpper[ i ] = ( gHalfPeriods[ i ] * t ) + t_error;
+		if( mUpper[ i ] > largest_upper )
+			largest_upper = mUpper[ i ];
+	}
+
+	mTableSize = ( largest_upper < U32( MaxTableSize ) ) ? largest_upper : U32( MaxTableSize );
+	mTable.resize( mTableSize + 1 );	// never empty, so &mTable[ 0 ] is valid
+	for( U32 distance = 0; distance < mTableSize; ++distance )
+		mTable[ distance ] = ClassifyByBounds( distance );
+}
+
+U8 DisplayPortAUXIntervalClassifier::ClassifyByBounds( U64 distance ) const
+{
+	U8 classes = AUXIntervalInvalid;
+	for( U32 i = 0; i < NumClasses; ++i )
+		if( ( distance > mLower[ i ] ) && ( distance < mUpper[ i ] ) )
+			classes |= U8( 1 << i );
+	return classes;
+}
+
+void DisplayPortAUXIntervalClassifier::ClassifyBlock( const U64* distances, U8* classes, U32 count ) const
+{
+	U32 i = 0;
+
+#ifdef DISPLAYPORTAUX_SSE2
+	// 4 distances per iteration: saturate to 32 bits (nothing above 0xFFFFFFFF can match),
+	// then do the unsigned window tests as signed compares on sign-flipped values.
+	const __m128i sign = _mm_set1_epi32( S32( 0x80000000 ) );
+	const __m128i zero = _mm_setzero_si128();
+	__m128i lower[ NumClasses ];
+	__m128i upper[ NumClasses ];
+	__m128i bit[ NumClasses ];
+	for( U32 k = 0; k < NumClasses; ++k )
+	{
+		lower[ k ] = _mm_xor_si128( _mm_set1_epi32( S32( mLower[ k ] ) ), sign );
+		upper[ k ] = _mm_xor_si128( _mm_set1_epi32( S32( mUpper[ k ] ) ), sign );
+		bit[ k ] = _mm_set1_epi32( 1 << k );
+	}
+
+	for( ; i + 4 <= count; i += 4 )
+	{
+		__m128 a = _mm_castsi128_ps( _mm_loadu_si128( ( const __m128i* )( distances + i ) ) );
+		__m128 b = _mm_castsi128_ps( _mm_loadu_si128( ( const __m128i* )( distances + i + 2 ) ) );
+		__m128i low = _mm_castps_si128( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+		__m128i high = _mm_castps_si128( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+		__m128i fits = _mm_cmpeq_epi32( high, zero );
+		__m128i value = _mm_or_si128( low, _mm_andnot_si128( fits, _mm_cmpeq_epi32( zero, zero ) ) );
+		value = _mm_xor_si128( value, sign );
+
+		__m128i result = zero;
+		for( U32 k = 0; k < NumClasses; ++k )
+		{
+			__m128i inside = _mm_and_si128( _mm_cmpgt_epi32( value, lower[ k ] ), _mm_cmpgt_epi32( upper[ k ], value ) );
+			result = _mm_or_si128( result, _mm_and_si128( inside, bit[ k ] ) );
+		}
+
+		result = _mm_packus_epi16( _mm_packs_epi32( result, zero ), zero );
+		U32 packed = U32( _mm_cvtsi128_si32( result ) );
+		classes[ i + 0 ] = U8( packed );
+		classes[ i + 1 ] = U8( packed >> 8 );
+		classes[ i + 2 ] = U8( packed >> 16 );
+		classes[ i + 3 ] = U8( packed >> 24 );
+	}
+#endif
+
+	for( ; i < count; ++i )
+		classes[ i ] = Classify( distances[ i ] );
+}
+
+DisplayPortAUXClockRecovery::DisplayPortAUXClockRecovery()
+:	mNominal( 0 ),
+	mHalfPeriod( 0 ),
+	mPhase( 0 ),
+	mSyncEdges( 0 ),
+	mSyncSum( 0.0 ),
+	mSyncMoment( 0.0 )
+{
+	for( U32 i = 0; i < 5; ++i )
+		mBounds[ i ] = 0;
+}
+
+void DisplayPortAUXClockRecovery::Init( U64 nominal_half_period )
+{
+	mNominal = nominal_half_period;
+	Reset();
+}
+
+void DisplayPortAUXClockRecovery::Reset()
+{
+	mPhase = 0;
+	mSyncEdges = 0;
+	mSyncSum = 0.0;
+	mSyncMoment = 0.0;
+	SetHalfPeriod( mNominal );
+}
+
+void DisplayPortAUXClockRecovery::SetFromSync( U64 span, U32 half_periods )
+{
+	if( ( half_periods == 0 ) || ( span >= MaxDistance ) )
+		return;
+	if( half_periods != mSyncEdges )
+	{
+		mPhase = 0;
+		SetHalfPeriod( ( span << 16 ) / half_periods );
+		return;
+	}
+
+	// Least squares line through the SYNC edges, the first one at ( 0, 0 ). At low oversampling a
+	// single edge is off by up to a sample, the line isn't, and it also tells how far off the grid the
+	// last edge is, which is where the START is measured from.
+	double n = double( half_periods ) + 1.0;
+	double mean_index = double( half_periods ) / 2.0;
+	double mean_offset = mSyncSum / n;
+	double slope = ( mSyncMoment - n * mean_index * mean_offset ) / ( n * ( n * n - 1.0 ) / 12.0 );
+	SetHalfPeriod( U64( slope * 65536.0 + 0.5 ) );
+	double last = mean_offset + ( double( half_periods ) - mean_index ) * double( mHalfPeriod ) / 65536.0;
+	mPhase = S64( ( double( span ) - last ) * 65536.0 );
+}
+
+void DisplayPortAUXClockRecovery::AddSyncEdge( U64 offset )
+{
+	++mSyncEdges;
+	mSyncSum += double( offset );
+	mSyncMoment += double( offset ) * double( mSyncEdges );
+}
+
+void DisplayPortAUXClockRecovery::Track( U64 distance, U8 interval )
+{
+	S64 half_periods;
+	if( interval == AUXIntervalT )
+		half_periods = 1;
+	else if( interval == AUXInterval2T )
+		half_periods = 2;
+	else if( interval == AUXInterval4T )
+		half_periods = 4;
+	else if( interval == AUXInterval5T )
+		half_periods = 5;
+	else
+		return;
+
+	S64 error = S64( distance << 16 ) + mPhase - half_periods * S64( mHalfPeriod );
+	mPhase = error - error / ( 1 << PhaseShift );
+	SetHalfPeriod( U64( S64( mHalfPeriod ) + error / ( half_periods << TrackingShift ) ) );
+}
+
+void DisplayPortAUXClockRecovery::SetHalfPeriod( U64 half_period )
+{
+	// SYNC half bits are found with the nominal classes, so a measurement can't be off by more than half
+	U64 lowest = mNominal - mNominal / 2;
+	U64 highest = mNominal + mNominal / 2;
+	if( half_period < lowest )
+		half_period = lowest;
+	if( half_period > highest )
+		half_period = highest;
+
+	mHalfPeriod = half_period;
+	mBounds[ 0 ] = half_period / 2;
+	mBounds[ 1 ] = half_period + half_period / 2;
+	mBounds[ 2 ] = half_period * 3;
+	mBounds[ 3 ] = half_period * 4 + half_period / 2;
+	mBounds[ 4 ] = half_period * 5 + half_period / 2;
+}
@@ -0,0 +1,103 @@
+#ifndef DISPLAYPORTAUX_INTERVAL_CLASSIFIER
+#define DISPLAYPORTAUX_INTERVAL_CLASSIFIER
+
+#include "DisplayPortAUXTypes.h"
+#include <vector>
+
+// Maps the distance between two edges to the Manchester symbol intervals it matches.
+// Every class is the open window ( k * mT - mTError, k * mT + mTError ). The windows may overlap
+// at low oversampling (mTError is at least 3 samples), so the result is a mask and the decoder
+// keeps testing the classes in the order the protocol needs. The bounds are computed once in Init(),
+// short distances are a single table lookup, longer ones a few comparisons.
+
+enum DisplayPortAUXInterval
+{
+	AUXIntervalInvalid = 0,
+	AUXIntervalT = 1 << 0,	// half bit
+	AUXInterval2T = 1 << 1,	// full bit
+	AUXInterval4T = 1 << 2,	// START/STOP after a 1
+	AUXInterval5T = 1 << 3	// START/STOP after a 0
+};
+
+class DisplayPortAUXIntervalClassifier
+{
+public:
+	DisplayPortAUXIntervalClassifier();
+
+	void Init( U32 t, U32 t_error );
+
+	U8 Classify( U64 distance ) const
+	{
+		if( distance < mTableSize )
+			return mTable[ U32( distance ) ];
+		return ClassifyByBounds( distance );
+	}
+
+	void ClassifyBlock( const U64* distances, U8* classes, U32 count ) const;	// SSE2 when available
+
+protected:
+	enum { MaxTableSize = 1 << 16, NumClasses = 4 };
+
+	U8 ClassifyByBounds( U64 distance ) const;
+
+	U32 mLower[ NumClasses ];	// exclusive
+	U32 mUpper[ NumClasses ];	// exclusive
+	std::vector< U8 > mTable;
+	U32 mTableSize;
+};
+
+// Classifier that follows the transmitter's clock, for low oversampling. The half period is kept
+// in 16.16 fixed point: it is fitted to the edges of every SYNC preamble (least squares, so a single
+// edge that is off by a sample barely moves it) and then tracks the intervals of the burst with a
+// second order loop, which also follows the phase of the edges against the recovered clock. The
+// classes don't overlap, every boundary is halfway between two symbol intervals, so with 3 samples
+// per half bit a distance that is off by a whole sample still classifies correctly. With 2 it may
+// not: the error is then half a class wide. A distance right on a boundary goes to the shorter
+// class: while hunting for SYNC the nominal clock is used, and a slow transmitter's half bits of
+// 2 and 3 samples must all count as SYNC.
+class DisplayPortAUXClockRecovery
+{
+public:
+	DisplayPortAUXClockRecovery();
+
+	void Init( U64 nominal_half_period );	// samples, 16.16 fixed point
+	void Reset();	// back to the nominal half period
+	void AddSyncEdge( U64 offset );	// samples from the first SYNC edge, one per SYNC half bit
+	void SetFromSync( U64 span, U32 half_periods );	// span of half_periods SYNC half bits, samples
+	void Track( U64 distance, U8 interval );	// distance of a classified interval within a burst
+
+	U8 Classify( U64 distance ) const
+	{
+		if( distance >= MaxDistance )
+			return AUXIntervalInvalid;
+
+		S64 value = S64( distance << 16 ) + mPhase;
+		if( ( value < S64( mBounds[ 0 ] ) ) || ( value > S64( mBounds[ 4 ] ) ) )
+			return AUXIntervalInvalid;
+		if( value <= S64( mBounds[ 1 ] ) )
+			return AUXIntervalT;
+		if( value <= S64( mBounds[ 2 ] ) )
+			return AUXInterval2T;
+		if( value <= S64( mBounds[ 3 ] ) )
+			return AUXInterval4T;
+		return AUXInterval5T;
+	}
+
+	U32 GetHalfPeriod() const { return U32( ( mHalfPeriod + 0x8000 ) >> 16 ); }	// samples, rounded
+
+protected:
+	enum { PhaseShift = 4, TrackingShift = 11 };	// loop gains: 1/16 of the error corrects the phase, 1/2048 the period
+	static const U64 MaxDistance = 1ULL << 40;
+
+	void SetHalfPeriod( U64 half_period );
+
+	U64 mNominal;
+	U64 mHalfPeriod;
+	S64 mPhase;	// where the last edge was against the recovered clock, 16.16 fixed point
+	U32 mSyncEdges;
+	double mSyncSum;
+	double mSyncMoment;
+	U64 mBounds[ 5 ];	// 0.5, 1.5, 3, 4.5 and 5.5 half periods, 16.16 fixed point
+};
+
+#endif //DISPLAYPORTAUX_INTERVAL_CLASSIFIER
@@ -0,0 +1,202 @@
+#include "DisplayPortAUXLineEncoder.h"
+#include "DisplayPortAUX8b10b.h"
+
+DisplayPortAUXLineEncoder::DisplayPortAUXLineEncoder()
+{
+	Init( 20000000, 1000000, false, false, false, 0, 0 );
+}
+
+void DisplayPortAUXLineEncoder::Init( U32 sample_rate_hz, U32 bit_rate, bool faux, bool inverted, bool lsb_first, U32 jitter_percent, U32 glitches_per_10k_runs )
+{
+	mSampleRateHz = sample_rate_hz;
+	mFaux = faux;
+	mIdleHigh = ( faux == true ) && ( inverted == true );
+	mHalfPeriod = ( U64( sample_rate_hz ) << FractionBits ) / ( U64( ( bit_rate != 0 ) ? bit_rate : 1 ) * 2 );
+	mJitter = mHalfPeriod * jitter_percent / 100;
+	mGlitchRate = glitches_per_10k_runs;
+
+	mRuns.clear();
+	if( faux == true )
+		BuildFaux( inverted );
+	else
+		BuildManchester( inverted, lsb_first );
+	mRdPositive = false;
+
+	mHigh = mIdleHigh;
+	mRunEnd = 0;
+	mLastEdge = 0;
+	mRandom = 0x9E3779B9;
+	mEdges.clear();
+}
+
+void DisplayPortAUXLineEncoder::BuildManchester( bool inverted, bool lsb_first )
+{
+	// a one is high then low; inverted swaps the data bits, SYNC, START and STOP keep their shape
+	std::vector< bool > half_bits;
+	for( U32 value = 0; value < 256; ++value )
+	{
+		half_bits.clear();
+		for( U32 i = 0; i < 8; ++i )
+		{
+			bool bit = ( ( value >> ( ( lsb_first == true ) ? i : 7 - i ) ) & 0x1 ) != 0;
+			bit = bit != inverted;
+			half_bits.push_back( bit );
+			half_bits.push_back( !bit );
+		}
+		mBytes[ value ] = MakeTemplate( half_bits, false );
+	}
+
+	half_bits.clear();
+	for( U32 i = 0; i < SyncZeros; ++i )
+	{
+		half_bits.push_back( false );
+		half_bits.push_back( true );
+	}
+	half_bits.insert( half_bits.end(), 4, true );
+	half_bits.insert( half_bits.end(), 4, false );
+	mSync = MakeTemplate( half_bits, false );
+
+	half_bits.clear();
+	half_bits.insert( half_bits.end(), 4, true );
+	half_bits.insert( half_bits.end(), 4, false );
+	mStop = MakeTemplate( half_bits, false );
+}
+
+void DisplayPortAUXLineEncoder::BuildFaux( bool inverted )
+{
+	// NRZ, one bit per full period, "a" bit first; unused K codes get an empty template
+	std::vector< bool > half_bits;
+	for( U32 rd = 0; rd < 2; ++rd )
+	{
+		for( U32 symbol = 0; symbol < U32( FauxSymbols ); ++symbol )
+		{
+			bool rd_positive = rd != 0;
+			U16 code = DisplayPortAUX8b10b::Encode( U16( symbol ), rd_positive );
+
+			half_bits.clear();
+			if( code != DisplayPortAUX8b10b::Invalid )
+			{
+				for( U32 i = 0; i < 10; ++i )
+				{
+					bool high = ( ( ( code >> ( 9 - i ) ) & 0x1 ) != 0 ) != inverted;
+					half_bits.push_back( high );
+					half_bits.push_back( high );
+				}
+			}
+			mSymbols[ rd ][ symbol ] = MakeTemplate( half_bits, rd_positive );
+		}
+	}
+}
+
+DisplayPortAUXLineEncoder::Template DisplayPortAUXLineEncoder::MakeTemplate( const std::vector< bool >& half_bits, bool rd_positive_after )
+{
+	Template symbol;
+	symbol.mOffset = U32( mRuns.size() );
+	symbol.mCount = 0;
+	symbol.mFirstHigh = ( half_bits.empty() == false ) && ( half_bits[ 0 ] == true );
+	symbol.mRdPositiveAfter = rd_positive_after;
+
+	for( U32 i = 0; i < U32( half_bits.size() ); ++i )
+	{
+		if( ( i == 0 ) || ( half_bits[ i ] != half_bits[ i - 1 ] ) )
+		{
+			mRuns.push_back( 0 );
+			++symbol.mCount;
+		}
+		++mRuns.back();
+	}
+	return symbol;
+}
+
+void DisplayPortAUXLineEncoder::AddBurst( const U8* bytes, U32 count )
+{
+	if( mFaux == false )
+	{
+		Append( mSync );
+		for( U32 i = 0; i < count; ++i )
+			Append( mBytes[ bytes[ i ] ] );
+		Append( mStop );
+		return;
+	}
+
+	for( U32 i = 0; i < PreambleCommas; ++i )
+		AppendFaux( DisplayPortAUX8b10b::K28_5 );
+	AppendFaux( DisplayPortAUX8b10b::K27_7 );	// START
+	for( U32 i = 0; i < count; ++i )
+		AppendFaux( bytes[ i ] );
+	AppendFaux( DisplayPortAUX8b10b::K29_7 );	// STOP
+}
+
+void DisplayPortAUXLineEncoder::AddIdleHalfBits( U32 half_bits )
+{
+	if( mHigh != mIdleHigh )
+		EndRun();
+	mRunEnd += U64( half_bits ) * mHalfPeriod;
+}
+
+void DisplayPortAUXLineEncoder::AddIdleNs( U64 ns )
+{
+	if( mHigh != mIdleHigh )
+		EndRun();
+
+	U64 product = ns * mSampleRateHz;
+	mRunEnd += ( ( product / 1000000000ull ) << FractionBits ) + ( ( ( product % 1000000000ull ) << FractionBits ) / 1000000000ull );
+}
+
+U64 DisplayPortAUXLineEncoder::GetSettledSample() const
+{
+	if( mGlitchRate != 0 )
+		return mLastEdge;	// a glitch may still go anywhere into the open run
+
+	U64 earliest = ( mRunEnd > mJitter ) ? ( mRunEnd - mJitter ) >> FractionBits : 0;
+	return ( earliest > mLastEdge ) ? earliest : mLastEdge;
+}
+
+void DisplayPortAUXLineEncoder::Append( const Template& symbol )
+{
+	const U8* runs = &mRuns[ symbol.mOffset ];
+	for( U32 i = 0; i < symbol.mCount; ++i )
+	{
+		if( ( i != 0 ) || ( symbol.mFirstHigh != mHigh ) )
+			EndRun();
+		mRunEnd += runs[ i ] * mHalfPeriod;
+	}
+}
+
+void DisplayPortAUXLineEncoder::AppendFaux( U16 symbol )
+{
+	const Template& code = mSymbols[ mRdPositive ? 1 : 0 ][ symbol & ( FauxSymbols - 1 ) ];
+	Append( code );
+	mRdPositive = code.mRdPositiveAfter;
+}
+
+void DisplayPortAUXLineEncoder::EndRun()
+{
+	S64 position = S64( mRunEnd );
+	if( mJitter != 0 )
+		position += S64( mJitter >> 15 ) * ( S64( Random( 65537 ) ) - 32768 );
+	U64 edge = U64( position + ( S64( 1 ) << ( FractionBits - 1 ) ) ) >> FractionBits;
+	if( edge <= mLastEdge )
+		edge = mLastEdge + 1;	// jitter never reorders edges
+
+	if( ( mGlitchRate != 0 ) && ( mLastEdge != 0 ) && ( edge - mLastEdge >= 4 ) && ( Random( 10000 ) < mGlitchRate ) )
+	{
+		U64 length = edge - mLastEdge;
+		U64 width = 1 + Random( ( length >= 16 ) ? U32( length / 8 ) : 1 );
+		U64 start = mLastEdge + ( length - width ) / 2;
+		mEdges.push_back( start );
+		mEdges.push_back( start + width );
+	}
+
+	mEdges.push_back( edge );
+	mLastEdge = edge;
+	mHigh = !mHigh;
+}
+
+U32 DisplayPortAUXLineEncoder::Random( U32 range )
+{
+	mRandom ^= mRandom << 13;
+	mRandom ^= mRandom >> 17;
+	mRandom ^= mRandom << 5;
+	return mRandom % range;
+}
@@ -0,0 +1,84 @@
+#ifndef DISPLAYPORTAUX_LINE_ENCODER
+#define DISPLAYPORTAUX_LINE_ENCODER
+
+#include "DisplayPortAUXTypes.h"
+#include <vector>
+
+// Turns bursts into the edges of the AUX line, the inverse of the decoders.
+// Every symbol the line can carry (a Manchester byte, the SYNC with START, STOP, or an 8b/10b code
+// in either running disparity) is built once, at Init(), as a run-length template: the level of its
+// first half bit and the lengths of its runs in half bits. Encoding a burst is then one table
+// lookup per symbol and one edge per run, with no per bit decisions. Runs at the same level are
+// merged across symbols, so a symbol that starts at the current level just extends the open run.
+// Positions are kept in 40.24 fixed point samples, so any bit rate can be generated without drift.
+// Jitter moves every edge by a random amount within +-jitter_percent of a half bit; a glitch is a
+// short pulse in the middle of a run, placed on a random run at the given rate.
+
+class DisplayPortAUXLineEncoder
+{
+public:
+	enum
+	{
+		FractionBits = 24,
+		SyncZeros = 32,			// precharge and SYNC, Manchester
+		PreambleCommas = 8		// K28.5 before the START, FAUX
+	};
+
+	DisplayPortAUXLineEncoder();
+
+	void Init( U32 sample_rate_hz, U32 bit_rate, bool faux, bool inverted, bool lsb_first, U32 jitter_percent, U32 glitches_per_10k_runs );
+
+	bool IsInitiallyHigh() const { return mIdleHigh; }
+
+	void AddBurst( const U8* bytes, U32 count );
+	void AddIdleHalfBits( U32 half_bits );
+	void AddIdleNs( U64 ns );
+
+	// edges generated so far, in order
+	std::vector< U64 >& GetEdges() { return mEdges; }
+	U64 GetSettledSample() const;	// the line is final up to here, no edge can come earlier any more
+
+protected:
+	struct Template
+	{
+		U32 mOffset;	// first run in mRuns
+		U32 mCount;
+		bool mFirstHigh;
+		bool mRdPositiveAfter;	// FAUX, running disparity after the code
+	};
+
+	enum { FauxSymbols = 512 };	// byte | KFlag
+
+	void BuildManchester( bool inverted, bool lsb_first );
+	void BuildFaux( bool inverted );
+	Template MakeTemplate( const std::vector< bool >& half_bits, bool rd_positive_after );
+
+	void Append( const Template& symbol );
+	void AppendFaux( U16 symbol );
+	void EndRun();
+	U32 Random( U32 range );
+
+	U32 mSampleRateHz;
+	bool mFaux;
+	bool mIdleHigh;
+	U64 mHalfPeriod;		// samples, fixed point
+	U64 mJitter;			// samples, fixed point, the largest offset either way
+	U32 mGlitchRate;		// per 10000 runs
+
+	std::vector< U8 > mRuns;	// lengths in half bits
+	Template mSync;			// Manchester: SYNC and START
+	Template mStop;			// Manchester
+	Template mBytes[ 256 ];	// Manchester
+	Template mSymbols[ 2 ][ FauxSymbols ];	// FAUX: [ rd_positive ][ symbol ]
+	bool mRdPositive;
+
+	// the run that is open, it ends with the next edge
+	bool mHigh;
+	U64 mRunEnd;			// fixed point, ideal position of its end, grows while symbols are appended
+	U64 mLastEdge;			// samples, as generated
+	U32 mRandom;
+
+	std::vector< U64 > mEdges;
+};
+
+#endif //DISPLAYPORTAUX_LINE_ENCODER
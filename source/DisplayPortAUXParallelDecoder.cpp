@@ -0,0 +1,408 @@
+#include "DisplayPortAUXParallelDecoder.h"
+
+// records a segment decoder's output for the merge
+class DisplayPortAUXSegmentSink : public DisplayPortAUXDecoderSink
+{
+public:
+	DisplayPortAUXSegmentSink( std::vector< DisplayPortAUXFrame >& frames, std::vector< U32 >& packet_ends, std::vector< DisplayPortAUXMarker >& markers )
+	:	mFrames( frames ),
+		mPacketEnds( packet_ends ),
+		mMarkers( markers )
+	{
+	}
+
+	virtual void AddFrame( const DisplayPortAUXFrame& frame ) { mFrames.push_back( frame ); }
+	virtual void AddMarkers( const DisplayPortAUXMarker* markers, U32 count ) { mMarkers.insert( mMarkers.end(), markers, markers + count ); }
+	virtual void CommitPacket( U32 /*transaction*/ ) { mPacketEnds.push_back( U32( mFrames.size() ) ); }	// the merge parses the transactions again
+	virtual void CommitResults( U64 /*sample_number*/ )
+	{
+	}
+
+protected:
+	std::vector< DisplayPortAUXFrame >& mFrames;
+	std::vector< U32 >& mPacketEnds;
+	std::vector< DisplayPortAUXMarker >& mMarkers;
+};
+
+// the pending edges, then the edges read on from the source; after a full block it ends at the first
+// edge after the next idle gap, which is left in pending for the segment that starts there
+class DisplayPortAUXParallelDecoder::TailSource : public DisplayPortAUXEdgeSource
+{
+public:
+	TailSource( DisplayPortAUXParallelDecoder& decoder, std::vector< U64 >& pending, bool pending_high )
+	:	mDecoder( decoder ),
+		mPending( pending ),
+		mNext( 0 ),
+		mInitiallyHigh( pending_high ),
+		mEdgesRead( 0 ),
+		mBehind( false ),
+		mEnd( false )
+	{
+	}
+
+	virtual bool IsInitiallyHigh() { return mInitiallyHigh; }
+
+	virtual U32 ReadEdges( U64* edges, U32 max_edges )
+	{
+		if( mEnd == true )
+			return 0;
+		if( ( mNext == mPending.size() ) && ( Refill() == false ) )
+			return 0;
+
+		size_t end = mPending.size();
+		if( mBehind == true )
+		{
+			for( size_t i = ( mNext != 0 ) ? mNext : 1; i < mPending.size(); ++i )
+			{
+				if( mPending[ i ] - mPending[ i - 1 ] > mDecoder.mIdleGap )
+				{
+					end = i + 1;
+					mEnd = true;
+					break;
+				}
+			}
+		}
+
+		U32 count = ( end - mNext < max_edges ) ? U32( end - mNext ) : max_edges;
+		for( U32 i = 0; i < count; ++i )
+			edges[ i ] = mPending[ mNext + i ];
+		mNext += count;
+		mEdgesRead += count;
+		if( mNext != end )
+			mEnd = false;	// the gap is in a later block
+		return count;
+	}
+
+	virtual bool WouldAdvancingToAbsPositionCauseTransition( U64 sample_number )
+	{
+		if( mEnd == true )
+			return false;	// like the end of a segment
+		if( mNext < mPending.size() )
+			return mPending[ mNext ] <= sample_number;
+		return mDecoder.mSource->WouldAdvancingToAbsPositionCauseTransition( sample_number );
+	}
+
+	// leaves the edges that weren't decoded in pending, from the last one read if the tail ended at a gap
+	void ReturnRest( bool& pending_high )
+	{
+		if( ( mEnd == true ) && ( mNext != 0 ) )
+		{
+			--mNext;
+			--mEdgesRead;
+		}
+		mPending.erase( mPending.begin(), mPending.begin() + mNext );
+		pending_high = ( ( mEdgesRead & 1 ) != 0 ) ? !mInitiallyHigh : mInitiallyHigh;
+	}
+
+protected:
+	bool Refill()
+	{
+		// the edge before the new block stays, the gap search needs it
+		mPending.erase( mPending.begin(), mPending.end() - ( mPending.empty() ? 0 : 1 ) );
+		mNext = mPending.size();
+
+		std::chrono::steady_clock::time_point read_start = std::chrono::steady_clock::now();
+		U32 count = mDecoder.mSource->ReadEdges( &mDecoder.mEdges[ 0 ], EdgeBufferSize );
+		mDecoder.mCounters.mSourceNs += std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - read_start ).count();
+		if( count == 0 )
+			return false;
+		mDecoder.mCounters.mEdges += count;
+		mPending.insert( mPending.end(), mDecoder.mEdges.begin(), mDecoder.mEdges.begin() + count );
+
+		if( count == EdgeBufferSize )
+			mBehind = true;	// more data has arrived than one read takes, worth the workers again
+		return true;
+	}
+
+	DisplayPortAUXParallelDecoder& mDecoder;
+	std::vector< U64 >& mPending;
+	size_t mNext;
+	bool mInitiallyHigh;	// before mPending[ 0 ] as it was first given
+	U64 mEdgesRead;
+	bool mBehind;
+	bool mEnd;
+};
+
+// merges the calling thread's decoder output as it comes, so nothing waits for the end of the tail
+class DisplayPortAUXParallelDecoder::TailSink : public DisplayPortAUXDecoderSink
+{
+public:
+	TailSink( DisplayPortAUXParallelDecoder& decoder )
+	:	mDecoder( decoder ),
+		mTailDecoder( NULL )
+	{
+	}
+
+	void SetDecoder( const DisplayPortAUXDecoder* tail_decoder ) { mTailDecoder = tail_decoder; }
+	void MergeCounters() { mDecoder.MergeCounters( mTailDecoder->GetCounters(), mMerged ); }
+
+	virtual void AddFrame( const DisplayPortAUXFrame& frame ) { mDecoder.MergeFrame( frame ); }
+	virtual void AddMarkers( const DisplayPortAUXMarker* markers, U32 count )
+	{
+		mDecoder.FlushMarkers();
+		mDecoder.mSink->AddMarkers( markers, count );
+	}
+	virtual void CommitPacket( U32 /*transaction*/ ) { mDecoder.EndBurst(); }	// parsed again by the merge, as for the segments
+	virtual void CommitResults( U64 /*sample_number*/ )
+	{
+		MergeCounters();
+		mDecoder.CommitResults( mDecoder.mPendingSample, true );
+	}
+
+protected:
+	DisplayPortAUXParallelDecoder& mDecoder;
+	const DisplayPortAUXDecoder* mTailDecoder;
+	DisplayPortAUXDecoderCounters mMerged;	// the part of mTailDecoder's counters already merged
+};
+
+DisplayPortAUXParallelDecoder::DisplayPortAUXParallelDecoder( const DisplayPortAUXDecoderConfig& config, const DecoderFactory& factory, U32 num_threads,
+	DisplayPortAUXEdgeSource* source, DisplayPortAUXDecoderSink* sink, U32 segment_edges )
+:	DisplayPortAUXDecoder( config, source, sink ),
+	mFactory( factory ),
+	mSegmentConfig( config ),
+	mNumThreads( GetNumThreads( num_threads ) ),
+	mSegmentEdges( ( segment_edges != 0 ) ? segment_edges : 1 ),
+	mIdleGap( U64( 2 * IdleGapBits ) * config.mT ),
+	mStop( false )
+{
+	mSegmentConfig.mDpcd = NULL;
+	mSegmentConfig.mEdid = NULL;
+	mSegmentConfig.mStatistics = NULL;
+}
+
+DisplayPortAUXParallelDecoder::~DisplayPortAUXParallelDecoder()
+{
+	StopWorkers();	// also when the SDK ends the thread from inside ReadEdges()
+}
+
+U32 DisplayPortAUXParallelDecoder::GetNumThreads( U32 num_threads )
+{
+	U32 num_cores = std::thread::hardware_concurrency();
+	if( num_cores == 0 )
+		num_cores = 1;	// unknown
+
+	if( ( num_threads == 0 ) || ( num_threads > num_cores ) )
+		return num_cores;	// more workers than cores only take turns with the calling thread
+	return num_threads;
+}
+
+void DisplayPortAUXParallelDecoder::Decode()
+{
+	StartWorkers();
+
+	std::vector< U64 > pending;	// edges not dispatched yet
+	bool pending_high = mHigh;	// line level before pending[ 0 ]
+
+	for( ; ; )
+	{
+		Merge( size_t( -1 ) );
+		CommitResults( mPendingSample, true );	// reading may block waiting for data (or end the thread), publish everything first
+
+		std::chrono::steady_clock::time_point read_start = std::chrono::steady_clock::now();
+		U32 count = mSource->ReadEdges( &mEdges[ 0 ], EdgeBufferSize );
+		mCounters.mSourceNs += std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - read_start ).count();
+		if( count == 0 )
+			break;
+		mCounters.mEdges += count;
+		pending.insert( pending.end(), mEdges.begin(), mEdges.begin() + count );
+
+		if( pending.size() >= mSegmentEdges )
+		{
+			size_t cut = FindCut( pending, pending.size() >= size_t( mSegmentEdges ) * MaxSegmentFactor );
+			if( cut != 0 )
+				Dispatch( pending, cut, true, pending_high );
+		}
+
+		if( count < EdgeBufferSize )	// caught up with the captured data, the next read may block
+		{
+			size_t cut = FindCut( pending, false );
+			if( cut != 0 )
+				Dispatch( pending, cut, true, pending_high );
+			Merge( 0 );
+			DecodeTail( pending, pending_high );
+		}
+	}
+
+	if( pending.empty() == false )
+		Dispatch( pending, pending.size(), false, pending_high );
+	Merge( 0 );
+	StopWorkers();
+}
+
+size_t DisplayPortAUXParallelDecoder::FindCut( const std::vector< U64 >& edges, bool force ) const
+{
+	// index of the first edge after the last idle gap, 0 if there is none
+	if( edges.size() < 2 )
+		return 0;
+
+	for( size_t i = edges.size() - 1; i > 0; --i )
+	{
+		if( edges[ i ] - edges[ i - 1 ] > mIdleGap )
+			return i;
+	}
+	if( force == false )
+		return 0;
+
+	// no idle line at all (noise?), the longest interval is the best guess
+	size_t longest = 0;
+	U64 longest_distance = 0;
+	for( size_t i = 1; i < edges.size(); ++i )
+	{
+		if( edges[ i ] - edges[ i - 1 ] > longest_distance )
+		{
+			longest = i;
+			longest_distance = edges[ i ] - edges[ i - 1 ];
+		}
+	}
+	return longest;
+}
+
+void DisplayPortAUXParallelDecoder::Dispatch( std::vector< U64 >& pending, size_t count, bool overlap, bool& pending_high )
+{
+	if( count == 0 )
+		return;
+
+	std::unique_ptr< Segment > segment( new Segment() );
+	segment->mEdges.assign( pending.begin(), pending.begin() + count + ( overlap ? 1 : 0 ) );
+	segment->mInitiallyHigh = pending_high;
+	segment->mDone = false;
+
+	if( ( count & 1 ) != 0 )
+		pending_high = !pending_high;
+	pending.erase( pending.begin(), pending.begin() + count );
+
+	Merge( size_t( mNumThreads ) * SegmentsPerThread - 1 );	// bounds the memory held by decoded segments
+
+	std::lock_guard< std::mutex > lock( mMutex );
+	mQueue.push_back( segment.get() );
+	mSegments.push_back( std::move( segment ) );
+	mChanged.notify_all();
+}
+
+void DisplayPortAUXParallelDecoder::DecodeSegment( Segment& segment )
+{
+	DisplayPortAUXArrayEdgeSource source( &segment.mEdges[ 0 ], segment.mEdges.size(), segment.mInitiallyHigh );
+	DisplayPortAUXSegmentSink sink( segment.mFrames, segment.mPacketEnds, segment.mMarkers );
+	std::unique_ptr< DisplayPortAUXDecoder > decoder( mFactory( mSegmentConfig, &source, &sink ) );
+	decoder->Run();
+
+	segment.mCounters = decoder->GetCounters();
+	std::vector< U64 >().swap( segment.mEdges );
+}
+
+void DisplayPortAUXParallelDecoder::Merge( size_t max_pending )
+{
+	// merges decoded segments in order, waiting until at most max_pending are left
+	for( ; ; )
+	{
+		std::unique_ptr< Segment > segment;
+		{
+			std::unique_lock< std::mutex > lock( mMutex );
+			if( mSegments.empty() == true )
+				return;
+			if( ( mSegments.front()->mDone == false ) && ( mSegments.size() <= max_pending ) )
+				return;
+			mChanged.wait( lock, [ & ]() { return mSegments.front()->mDone == true; } );
+			segment = std::move( mSegments.front() );
+			mSegments.pop_front();
+		}
+
+		MergeSegment( *segment );
+	}
+}
+
+void DisplayPortAUXParallelDecoder::MergeSegment( const Segment& segment )
+{
+	if( segment.mMarkers.empty() == false )
+	{
+		FlushMarkers();
+		mSink->AddMarkers( &segment.mMarkers[ 0 ], U32( segment.mMarkers.size() ) );
+	}
+
+	size_t packet = 0;
+	for( size_t i = 0; i < segment.mFrames.size(); ++i )
+	{
+		MergeFrame( segment.mFrames[ i ] );
+
+		for( ; ( packet < segment.mPacketEnds.size() ) && ( segment.mPacketEnds[ packet ] == i + 1 ); ++packet )
+			EndBurst();
+		CommitResults( mPendingSample, false );
+	}
+
+	DisplayPortAUXDecoderCounters merged;
+	MergeCounters( segment.mCounters, merged );
+}
+
+void DisplayPortAUXParallelDecoder::MergeFrame( const DisplayPortAUXFrame& frame )
+{
+	mFrame = frame;
+	if( mFrame.mType == AUXStart )
+		mFrame.mData1 = ++mPacketNum;	// the segment decoders count from 1
+	AddFrame();
+}
+
+void DisplayPortAUXParallelDecoder::MergeCounters( const DisplayPortAUXDecoderCounters& counters, DisplayPortAUXDecoderCounters& merged )
+{
+	// adds what a segment decoder counted since merged; bytes, bursts and syncs are counted by AddFrame(), edges when they are read
+	mCounters.mSyncLost += counters.mSyncLost - merged.mSyncLost;
+	mCounters.mSkippedEdges += counters.mSkippedEdges - merged.mSkippedEdges;
+	for( U32 i = 0; i < AUXErrorCount; ++i )
+		mCounters.mErrors[ i ] += counters.mErrors[ i ] - merged.mErrors[ i ];
+	merged = counters;
+}
+
+void DisplayPortAUXParallelDecoder::DecodeTail( std::vector< U64 >& pending, bool& pending_high )
+{
+	// decodes on this thread until the source is a full block behind again, or out of edges
+	TailSource source( *this, pending, pending_high );
+	TailSink sink( *this );
+	std::unique_ptr< DisplayPortAUXDecoder > decoder( mFactory( mSegmentConfig, &source, &sink ) );
+	sink.SetDecoder( decoder.get() );
+	decoder->Run();
+
+	sink.MergeCounters();
+	source.ReturnRest( pending_high );
+}
+
+void DisplayPortAUXParallelDecoder::StartWorkers()
+{
+	mStop = false;
+	for( U32 i = 0; i < mNumThreads; ++i )
+	{
+		mWorkers.push_back( std::thread( [ this ]()
+		{
+			for( ; ; )
+			{
+				Segment* segment;
+				{
+					std::unique_lock< std::mutex > lock( mMutex );
+					mChanged.wait( lock, [ this ]() { return ( mStop == true ) || ( mQueue.empty() == false ); } );
+					if( mStop == true )
+						return;
+					segment = mQueue.front();
+					mQueue.pop_front();
+				}
+
+				DecodeSegment( *segment );
+
+				std::lock_guard< std::mutex > lock( mMutex );
+				segment->mDone = true;
+				mChanged.notify_all();
+			}
+		} ) );
+	}
+}
+
+void DisplayPortAUXParallelDecoder::StopWorkers()
+{
+	{
+		std::lock_guard< std::mutex > lock( mMutex );
+		mStop = true;
+		mChanged.notify_all();
+	}
+
+	for( size_t i = 0; i < mWorkers.size(); ++i )
+		mWorkers[ i ].join();
+	mWorkers.clear();
+	mQueue.clear();
+}
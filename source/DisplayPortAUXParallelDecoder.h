@@ -0,0 +1,91 @@
+#ifndef DISPLAYPORTAUX_PARALLEL_DECODER
+#define DISPLAYPORTAUX_PARALLEL_DECODER
+
+#include "DisplayPortAUXDecoder.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Decodes a capture on several cores. Every burst ends with an idle line, so the edge stream is
+// cut into segments at idle gaps longer than IdleGapBits bits, where no decoder carries any state
+// over. Each segment is decoded on its own by an ordinary line coding decoder (made by the
+// factory) on a worker thread, into memory. The calling thread merges the segments strictly in
+// time order: frames go through this decoder's transaction parser (so DPCD, EDID and statistics
+// are updated serially, exactly as with one decoder), START frames are renumbered, and markers,
+// packets and commits go to the sink.
+// A segment also gets the first edge after its gap, so a STOP or a symbol that ends at the idle
+// level is complete; the next segment starts at that edge.
+// Once the source has caught up with the captured data, the calling thread decodes the rest itself,
+// reading on from the source like the serial decoder, so the last burst is decoded before a read
+// blocks (or ends the thread). When a read returns a full block again, it hands the edges after
+// the next idle gap back to the workers.
+
+class DisplayPortAUXParallelDecoder : public DisplayPortAUXDecoder
+{
+public:
+	typedef std::function< DisplayPortAUXDecoder* ( const DisplayPortAUXDecoderConfig& config, DisplayPortAUXEdgeSource* source, DisplayPortAUXDecoderSink* sink ) > DecoderFactory;
+
+	enum { DefaultSegmentEdges = 65536 };
+
+	DisplayPortAUXParallelDecoder( const DisplayPortAUXDecoderConfig& config, const DecoderFactory& factory, U32 num_threads,	// 0: one per core
+		DisplayPortAUXEdgeSource* source, DisplayPortAUXDecoderSink* sink, U32 segment_edges = DefaultSegmentEdges );
+	virtual ~DisplayPortAUXParallelDecoder();
+
+	// the workers num_threads stands for, at most one per core; with one, the serial decoder is faster
+	static U32 GetNumThreads( U32 num_threads );
+
+protected:
+	enum
+	{
+		IdleGapBits = 8,
+		SegmentsPerThread = 4,
+		MaxSegmentFactor = 16	// without any idle gap a segment is cut at its longest interval after this many times the segment size
+	};
+
+	struct Segment
+	{
+		std::vector< U64 > mEdges;
+		bool mInitiallyHigh;
+		bool mDone;
+
+		// decoder output
+		std::vector< DisplayPortAUXFrame > mFrames;
+		std::vector< U32 > mPacketEnds;	// number of frames at every CommitPacket()
+		std::vector< DisplayPortAUXMarker > mMarkers;
+		DisplayPortAUXDecoderCounters mCounters;
+	};
+
+	class TailSource;
+	class TailSink;
+
+	virtual void Decode();
+
+	size_t FindCut( const std::vector< U64 >& edges, bool force ) const;
+	void Dispatch( std::vector< U64 >& pending, size_t count, bool overlap, bool& pending_high );
+	void DecodeSegment( Segment& segment );
+	void Merge( size_t max_pending );
+	void MergeSegment( const Segment& segment );
+	void MergeFrame( const DisplayPortAUXFrame& frame );
+	void MergeCounters( const DisplayPortAUXDecoderCounters& counters, DisplayPortAUXDecoderCounters& merged );
+	void DecodeTail( std::vector< U64 >& pending, bool& pending_high );
+	void StartWorkers();
+	void StopWorkers();
+
+	DecoderFactory mFactory;
+	DisplayPortAUXDecoderConfig mSegmentConfig;	// without the shared protocol layers
+	U32 mNumThreads;
+	U32 mSegmentEdges;
+	U64 mIdleGap;	// samples
+
+	std::vector< std::thread > mWorkers;
+	std::mutex mMutex;
+	std::condition_variable mChanged;
+	std::deque< std::unique_ptr< Segment > > mSegments;	// dispatched and not merged yet, in time order
+	std::deque< Segment* > mQueue;	// not decoded yet
+	bool mStop;
+};
+
+#endif //DISPLAYPORTAUX_PARALLEL_DECODER
@@ -0,0 +1,101 @@
+#include "DisplayPortAUXParallelExport.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+DisplayPortAUXParallelExport::DisplayPortAUXParallelExport( U32 num_threads )
+:	mNumThreads( num_threads )
+{
+	if( mNumThreads == 0 )
+		mNumThreads = std::thread::hardware_concurrency();
+	if( mNumThreads == 0 )
+		mNumThreads = 1;
+}
+
+bool DisplayPortAUXParallelExport::Run( U64 num_chunks, const FetchFunction& fetch, const FormatFunction& format, DisplayPortAUXExportWriter& writer, const ProgressFunction& progress )
+{
+	if( ( mNumThreads == 1 ) || ( num_chunks <= 1 ) )
+	{
+		for( U64 chunk = 0; chunk < num_chunks; ++chunk )
+		{
+			fetch( chunk, 0 );
+			format( chunk, 0, writer );
+			if( progress( chunk ) == true )
+				return false;
+		}
+		return true;
+	}
+
+	// chunk c is fetched and formatted into slot c % window; a slot is reused once its chunk has been written
+	U64 window = GetNumSlots();
+	std::vector< DisplayPortAUXExportWriter > slots( static_cast< size_t >( window ) );
+	std::vector< bool > ready( static_cast< size_t >( window ), false );
+	std::mutex mutex;
+	std::condition_variable changed;
+	U64 next_chunk = 0;
+	U64 fetched_chunks = 0;
+	bool cancelled = false;
+
+	std::vector< std::thread > workers;
+	for( U32 i = 0; i < mNumThreads; ++i )
+	{
+		workers.push_back( std::thread( [ & ]()
+		{
+			for( ; ; )
+			{
+				U64 chunk;
+				{
+					std::unique_lock< std::mutex > lock( mutex );
+					changed.wait( lock, [ & ]() { return ( cancelled == true ) || ( next_chunk >= num_chunks ) || ( next_chunk < fetched_chunks ); } );
+					if( ( cancelled == true ) || ( next_chunk >= num_chunks ) )
+						return;
+					chunk = next_chunk++;
+				}
+
+				DisplayPortAUXExportWriter& out = slots[ size_t( chunk % window ) ];
+				out.Clear();
+				format( chunk, U32( chunk % window ), out );
+
+				std::lock_guard< std::mutex > lock( mutex );
+				ready[ size_t( chunk % window ) ] = true;
+				changed.notify_all();
+			}
+		} ) );
+	}
+
+	for( U64 chunk = 0; chunk < num_chunks; ++chunk )
+	{
+		// fill the free slots, the workers only see a chunk once it is fetched
+		while( ( fetched_chunks < num_chunks ) && ( fetched_chunks < chunk + window ) )
+		{
+			fetch( fetched_chunks, U32( fetched_chunks % window ) );
+
+			std::lock_guard< std::mutex > lock( mutex );
+			++fetched_chunks;
+			changed.notify_all();
+		}
+
+		size_t slot = size_t( chunk % window );
+		{
+			std::unique_lock< std::mutex > lock( mutex );
+			changed.wait( lock, [ & ]() { return ready[ slot ] == true; } );
+		}
+
+		writer.Append( slots[ slot ] );
+
+		bool cancel = progress( chunk );
+		{
+			std::lock_guard< std::mutex > lock( mutex );
+			ready[ slot ] = false;
+			cancelled = cancel;
+			changed.notify_all();
+		}
+		if( cancel == true )
+			break;
+	}
+
+	for( size_t i = 0; i < workers.size(); ++i )
+		workers[ i ].join();
+
+	return cancelled == false;
+}
@@ -0,0 +1,36 @@
+#ifndef DISPLAYPORTAUX_PARALLEL_EXPORT
+#define DISPLAYPORTAUX_PARALLEL_EXPORT
+
+#include "DisplayPortAUXExportWriter.h"
+#include <functional>
+
+// Runs an export on all cores. The frames are split into chunks; worker threads format chunks into
+// separate memory writers, and the calling thread appends them to the file writer strictly in chunk
+// order. The calling thread also reports progress after every chunk, so cancelling keeps working.
+// At most a few chunks per thread are formatted ahead of the one being written, which bounds the
+// memory used.
+// The SDK doesn't promise that AnalyzerResults can be read from several threads at once, so the
+// calling thread fetches every chunk's input (the frames) before a worker gets it. A chunk has a
+// slot, 0 .. GetNumSlots() - 1, for that input; the slot stays with the chunk until it is written.
+
+class DisplayPortAUXParallelExport
+{
+public:
+	typedef std::function< void ( U64 chunk, U32 slot ) > FetchFunction;	// on the calling thread, in chunk order
+	typedef std::function< void ( U64 chunk, U32 slot, DisplayPortAUXExportWriter& out ) > FormatFunction;
+	typedef std::function< bool ( U64 chunk ) > ProgressFunction;	// returns true to cancel
+
+	DisplayPortAUXParallelExport( U32 num_threads = 0 );	// 0: one per core
+
+	U32 GetNumSlots() const { return ( mNumThreads == 1 ) ? 1 : mNumThreads * ChunksPerThread; }
+
+	// false if cancelled
+	bool Run( U64 num_chunks, const FetchFunction& fetch, const FormatFunction& format, DisplayPortAUXExportWriter& writer, const ProgressFunction& progress );
+
+protected:
+	enum { ChunksPerThread = 4 };
+
+	U32 mNumThreads;
+};
+
+#endif //DISPLAYPORTAUX_PARALLEL_EXPORT
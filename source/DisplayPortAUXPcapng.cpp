@@ -0,0 +1,122 @@
+#include "DisplayPortAUXPcapng.h"
+#include <stdio.h>
+#include <string.h>
+
+DisplayPortAUXPcapngWriter::DisplayPortAUXPcapngWriter( DisplayPortAUXExportWriter* out, U32 sample_rate_hz, S64 trigger_sample )
+:	mOut( out ),
+	mSampleRateHz( ( sample_rate_hz != 0 ) ? sample_rate_hz : 1 )
+{
+	mBlock.reserve( 256 );
+
+	StartBlock( BlockSectionHeader );
+	Put32( 0x1A2B3C4D );	// byte order magic
+	Put16( 1 );				// version 1.0
+	Put16( 0 );
+	Put64( ~U64( 0 ) );		// section length not known
+	PutOption( OptionShbUserApplication, "DisplayPort AUX Analyzer" );
+	PutOption( OptionEnd, NULL, 0 );
+	EndBlock();
+
+	U64 trigger_ns = GetTimestamp( trigger_sample );
+	char comment[ 128 ];
+	sprintf( comment, "trigger at sample %lld, %llu.%09llu s", trigger_sample, trigger_ns / 1000000000ULL, trigger_ns % 1000000000ULL );
+	U8 resolution = 9;	// 10^-9 s
+
+	StartBlock( BlockInterfaceDescription );
+	Put16( LinkTypeDpAuxMon );
+	Put16( 0 );
+	Put32( 0 );				// no snap length
+	PutOption( OptionIfName, "DisplayPort AUX" );
+	PutOption( OptionIfTsResolution, &resolution, 1 );
+	PutOption( OptionComment, comment );
+	PutOption( OptionEnd, NULL, 0 );
+	EndBlock();
+}
+
+void DisplayPortAUXPcapngWriter::AddPacket( S64 sample_number, DisplayPortAUXPcapngDirection direction, const U8* data, U32 count, bool incomplete )
+{
+	U64 timestamp = GetTimestamp( sample_number );
+	U8 pseudo_header = ( direction == AUXPcapngSinkToSource ) ? 1 : 0;
+
+	StartBlock( BlockEnhancedPacket );
+	Put32( 0 );				// interface
+	Put32( U32( timestamp >> 32 ) );
+	Put32( U32( timestamp ) );
+	Put32( count + 1 );		// captured length
+	Put32( count + 1 );		// original length
+	Put8( pseudo_header );
+	PutBytes( data, count );
+	mBlock.resize( ( mBlock.size() + 3 ) & ~size_t( 3 ) );	// pads the pseudo-header too
+
+	U32 flags = 0;
+	if( direction == AUXPcapngSinkToSource )
+		flags = 1;	// inbound
+	else if( direction == AUXPcapngSourceToSink )
+		flags = 2;	// outbound
+	PutOption( OptionEpbFlags, &flags, 4 );
+	if( incomplete == true )
+		PutOption( OptionComment, "incomplete burst, no STOP" );
+	PutOption( OptionEnd, NULL, 0 );
+	EndBlock();
+}
+
+void DisplayPortAUXPcapngWriter::StartBlock( U32 type )
+{
+	mBlock.clear();
+	Put32( type );
+	Put32( 0 );	// total length, set by EndBlock()
+}
+
+void DisplayPortAUXPcapngWriter::EndBlock()
+{
+	U32 length = U32( mBlock.size() ) + 4;
+	Put32( length );
+	memcpy( &mBlock[ 4 ], &length, 4 );
+	mOut->Append( &mBlock[ 0 ], U32( mBlock.size() ) );
+}
+
+void DisplayPortAUXPcapngWriter::Put16( U16 value )
+{
+	PutBytes( &value, 2 );
+}
+
+void DisplayPortAUXPcapngWriter::Put32( U32 value )
+{
+	PutBytes( &value, 4 );
+}
+
+void DisplayPortAUXPcapngWriter::Put64( U64 value )
+{
+	PutBytes( &value, 8 );
+}
+
+void DisplayPortAUXPcapngWriter::PutBytes( const void* data, U32 count )
+{
+	// pcapng is written in host byte order, the byte order magic tells readers which one
+	size_t used = mBlock.size();
+	mBlock.resize( used + count );
+	memcpy( &mBlock[ used ], data, count );
+}
+
+void DisplayPortAUXPcapngWriter::PutOption( U16 code, const void* data, U16 length )
+{
+	Put16( code );
+	Put16( length );
+	if( length != 0 )
+		PutBytes( data, length );
+	mBlock.resize( ( mBlock.size() + 3 ) & ~size_t( 3 ) );
+}
+
+void DisplayPortAUXPcapngWriter::PutOption( U16 code, const char* str )
+{
+	PutOption( code, str, U16( strlen( str ) ) );
+}
+
+U64 DisplayPortAUXPcapngWriter::GetTimestamp( S64 sample_number ) const
+{
+	if( sample_number < 0 )
+		return 0;
+
+	U64 sample = U64( sample_number );
+	return ( sample / mSampleRateHz ) * 1000000000ULL + ( ( sample % mSampleRateHz ) * 1000000000ULL ) / mSampleRateHz;
+}
@@ -0,0 +1,60 @@
+#ifndef DISPLAYPORTAUX_PCAPNG
+#define DISPLAYPORTAUX_PCAPNG
+
+#include "DisplayPortAUXExportWriter.h"
+#include <vector>
+
+// Streams AUX bursts as a pcapng file: one section header, one interface (link type DPAUXMON, 275,
+// nanosecond timestamps) and one enhanced packet block per START..STOP burst. Every packet is the
+// 1 byte DPAUXMON pseudo-header (bit 0: 0 = source to sink, 1 = sink to source) followed by the raw
+// burst bytes. Timestamps count from the start of the capture; the trigger time is recorded in the
+// interface comment. Blocks are formatted into a reused buffer and go through the export writer, so
+// the file is written in large blocks.
+
+enum DisplayPortAUXPcapngDirection
+{
+	AUXPcapngUnknown,
+	AUXPcapngSourceToSink,	// requests
+	AUXPcapngSinkToSource	// replies
+};
+
+class DisplayPortAUXPcapngWriter
+{
+public:
+	DisplayPortAUXPcapngWriter( DisplayPortAUXExportWriter* out, U32 sample_rate_hz, S64 trigger_sample );
+
+	// incomplete: the burst ended without STOP
+	void AddPacket( S64 sample_number, DisplayPortAUXPcapngDirection direction, const U8* data, U32 count, bool incomplete );
+
+protected:
+	enum
+	{
+		LinkTypeDpAuxMon = 275,
+		BlockSectionHeader = 0x0A0D0D0A,
+		BlockInterfaceDescription = 1,
+		BlockEnhancedPacket = 6,
+		OptionEnd = 0,
+		OptionComment = 1,
+		OptionShbUserApplication = 4,
+		OptionIfName = 2,
+		OptionIfTsResolution = 9,
+		OptionEpbFlags = 2
+	};
+
+	void StartBlock( U32 type );
+	void EndBlock();
+	void Put8( U8 value ) { mBlock.push_back( value ); }
+	void Put16( U16 value );
+	void Put32( U32 value );
+	void Put64( U64 value );
+	void PutBytes( const void* data, U32 count );
+	void PutOption( U16 code, const void* data, U16 length );
+	void PutOption( U16 code, const char* str );
+	U64 GetTimestamp( S64 sample_number ) const;	// nanoseconds
+
+	DisplayPortAUXExportWriter* mOut;
+	U32 mSampleRateHz;
+	std::vector< U8 > mBlock;
+};
+
+#endif //DISPLAYPORTAUX_PCAPNG
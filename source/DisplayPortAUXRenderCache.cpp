@@ -0,0 +1,109 @@
+#include "DisplayPortAUXRenderCache.h"
+#include <string.h>
+
+DisplayPortAUXRenderCache::DisplayPortAUXRenderCache( U32 capacity )
+:	mCapacity( ( capacity != 0 ) ? capacity : 1 ),
+	mNewest( NoEntry ),
+	mOldest( NoEntry ),
+	mHits( 0 ),
+	mMisses( 0 )
+{
+
+}
+
+U32 DisplayPortAUXRenderCache::Find( U64 frame_index, DisplayBase display_base, View view, char* text )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	std::unordered_map< U64, U32 >::const_iterator it = mIndex.find( GetKey( frame_index, display_base, view ) );
+	if( it == mIndex.end() )
+	{
+		++mMisses;
+		return 0;
+	}
+
+	U32 index = it->second;
+	if( index != mNewest )
+	{
+		Unlink( index );
+		LinkNewest( index );
+	}
+
+	++mHits;
+	Entry& entry = mEntries[ index ];
+	memcpy( text, entry.mText, entry.mLength );
+	return entry.mLength;
+}
+
+void DisplayPortAUXRenderCache::Insert( U64 frame_index, DisplayBase display_base, View view, const char* text, U32 length )
+{
+	if( ( length == 0 ) || ( length > MaxTextLength ) )
+		return;
+
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	U64 key = GetKey( frame_index, display_base, view );
+	if( mIndex.find( key ) != mIndex.end() )	// another thread formatted it meanwhile
+		return;
+
+	if( mEntries.empty() == true )
+	{
+		mEntries.resize( mCapacity );
+		mIndex.reserve( mCapacity );
+	}
+
+	U32 index;
+	if( mIndex.size() < mCapacity )
+	{
+		index = U32( mIndex.size() );
+	}
+	else
+	{
+		// reuse the least recently used entry
+		index = mOldest;
+		Unlink( index );
+		mIndex.erase( mEntries[ index ].mKey );
+	}
+
+	Entry& entry = mEntries[ index ];
+	entry.mKey = key;
+	entry.mLength = length;
+	memcpy( entry.mText, text, length );
+	mIndex[ key ] = index;
+	LinkNewest( index );
+}
+
+void DisplayPortAUXRenderCache::Clear()
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	mIndex.clear();
+	mNewest = NoEntry;
+	mOldest = NoEntry;
+}
+
+void DisplayPortAUXRenderCache::Unlink( U32 index )
+{
+	Entry& entry = mEntries[ index ];
+	if( entry.mNewer != NoEntry )
+		mEntries[ entry.mNewer ].mOlder = entry.mOlder;
+	else
+		mNewest = entry.mOlder;
+
+	if( entry.mOlder != NoEntry )
+		mEntries[ entry.mOlder ].mNewer = entry.mNewer;
+	else
+		mOldest = entry.mNewer;
+}
+
+void DisplayPortAUXRenderCache::LinkNewest( U32 index )
+{
+	Entry& entry = mEntries[ index ];
+	entry.mNewer = NoEntry;
+	entry.mOlder = mNewest;
+	if( mNewest != NoEntry )
+		mEntries[ mNewest ].mNewer = index;
+	else
+		mOldest = index;
+	mNewest = index;
+}
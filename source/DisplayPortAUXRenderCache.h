@@ -0,0 +1,59 @@
+#ifndef DISPLAYPORTAUX_RENDER_CACHE
+#define DISPLAYPORTAUX_RENDER_CACHE
+
+#include <AnalyzerTypes.h>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Formatted bubble and tabular text of recently drawn frames. Logic asks for the text of the same
+// frames on every repaint while zooming and panning, and a frame never changes once it is added, so
+// the text is kept per (frame index, display base, view) and only formatted on a miss. The entries
+// live in one preallocated array, linked in least recently used order; when it is full the oldest
+// entry is reused, so the cache never grows and a hit allocates nothing.
+// A text is a sequence of zero terminated strings, one per AddResultString/AddTabularText call.
+// Called from the UI threads.
+
+class DisplayPortAUXRenderCache
+{
+public:
+	enum View { BubbleView, TabularView };
+	enum { DefaultCapacity = 8192, MaxTextLength = 256 };
+
+	DisplayPortAUXRenderCache( U32 capacity = DefaultCapacity );
+
+	// copies the text into text (MaxTextLength bytes), returns its length, 0 on a miss
+	U32 Find( U64 frame_index, DisplayBase display_base, View view, char* text );
+	void Insert( U64 frame_index, DisplayBase display_base, View view, const char* text, U32 length );	// longer texts aren't kept
+	void Clear();
+
+	U64 GetHits() const { return mHits; }
+	U64 GetMisses() const { return mMisses; }
+
+protected:
+	enum { NoEntry = 0xFFFFFFFF };
+
+	struct Entry
+	{
+		U64 mKey;
+		U32 mNewer;		// towards mNewest
+		U32 mOlder;		// towards mOldest
+		U32 mLength;
+		char mText[ MaxTextLength ];
+	};
+
+	static U64 GetKey( U64 frame_index, DisplayBase display_base, View view ) { return ( frame_index << 4 ) | ( U64( display_base ) << 1 ) | U64( view ); }
+	void Unlink( U32 index );
+	void LinkNewest( U32 index );
+
+	std::mutex mMutex;
+	U32 mCapacity;
+	std::vector< Entry > mEntries;	// allocated on the first insert
+	std::unordered_map< U64, U32 > mIndex;	// key -> entry
+	U32 mNewest;
+	U32 mOldest;
+	U64 mHits;
+	U64 mMisses;
+};
+
+#endif //DISPLAYPORTAUX_RENDER_CACHE
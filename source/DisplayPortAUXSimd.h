@@ -0,0 +1,12 @@
+#ifndef DISPLAYPORTAUX_SIMD
+#define DISPLAYPORTAUX_SIMD
+
+// DISPLAYPORTAUX_SSE2 is defined where SSE2 can be used unconditionally (x64, or x86 built with SSE2).
+// Every kernel that uses it keeps a scalar loop that gives the same results.
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#define DISPLAYPORTAUX_SSE2
+	#include <emmintrin.h>
+#endif
+
+#endif //DISPLAYPORTAUX_SIMD
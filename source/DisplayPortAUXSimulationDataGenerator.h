@@ -2,9 +2,14 @@
 #define DISPLAYPORTAUX_SIMULATION_DATA_GENERATOR
 
 #include <AnalyzerHelpers.h>
+#include "DisplayPortAUXTrafficScenario.h"
+#include "DisplayPortAUXLineEncoder.h"
 
 class DisplayPortAUXAnalyzerSettings;
 
+// The scenario decides what is sent, the line encoder how it looks on the wire; this class only
+// hands the encoded edges to the SDK.
+
 class DisplayPortAUXSimulationDataGenerator
 {
 public:
@@ -15,17 +20,10 @@ public:
 	U32 GenerateSimulationData( U64 newest_sample_requested, U32 sample_rate, SimulationChannelDescriptor** simulation_channels );
 
 protected:
+	void FlushEdges();
 
-	U64 UsToSamples( U64 us );
-	U64 UsToSamples( double us );
-	U64 SamplesToUs( U64 samples );
-
-	void SimWriteByte( U64 value );
-	void SimWriteBit( U32 bit );
-	void SimWriteStartStop();
-
-	U64 mT;
-	U64 mSimValue;
+	DisplayPortAUXTrafficScenario mScenario;
+	DisplayPortAUXLineEncoder mEncoder;
 
 	DisplayPortAUXAnalyzerSettings* mSettings;
 	U32 mSimulationSampleRateHz;
@@ -0,0 +1,206 @@
+#include "DisplayPortAUXStatistics.h"
+#include "DisplayPortAUXTransaction.h"
+
+static const char* gErrorNames[] =	// indexed by DisplayPortAUXDecodeError
+{
+	"START, long first data half-bit",
+	"START, bad second half",
+	"data, second half-bit not short",
+	"data, bad bit interval",
+	"byte end, second half-bit neither short nor STOP",
+	"byte end, neither data bit nor STOP",
+	"STOP, transition in second half",
+	"FAUX, invalid 8b/10b code",
+	"FAUX, unexpected symbol",
+	"FAUX, idle line before STOP"
+};
+
+const char* DisplayPortAUXDecoderCounters::GetErrorName( U32 error )
+{
+	return ( error < AUXErrorCount ) ? gErrorNames[ error ] : "";
+}
+
+void DisplayPortAUXRange::Add( U64 value )
+{
+	if( ( mCount == 0 ) || ( value < mMin ) )
+		mMin = value;
+	if( ( mCount == 0 ) || ( value > mMax ) )
+		mMax = value;
+	mSum += value;
+	++mCount;
+}
+
+void DisplayPortAUXHistogram::Init( U64 bucket_width, U32 num_buckets, bool logarithmic )
+{
+	mCounts.assign( ( num_buckets != 0 ) ? num_buckets : 1, 0 );
+	mBucketWidth = ( bucket_width != 0 ) ? bucket_width : 1;
+	mLogarithmic = logarithmic;
+	mRange = DisplayPortAUXRange();
+}
+
+void DisplayPortAUXHistogram::Add( U64 value )
+{
+	U64 bucket = value / mBucketWidth;
+	if( mLogarithmic == true )
+	{
+		U64 log = 0;
+		for( ; bucket != 0; bucket >>= 1 )
+			++log;
+		bucket = log;
+	}
+
+	if( bucket >= mCounts.size() )
+		bucket = mCounts.size() - 1;
+	++mCounts[ size_t( bucket ) ];
+	mRange.Add( value );
+}
+
+U64 DisplayPortAUXHistogram::GetBucketStart( U32 bucket ) const
+{
+	if( mLogarithmic == false )
+		return bucket * mBucketWidth;
+	return ( bucket == 0 ) ? 0 : mBucketWidth << ( bucket - 1 );
+}
+
+DisplayPortAUXStatistics::DisplayPortAUXStatistics()
+{
+	Clear();
+}
+
+void DisplayPortAUXStatistics::Clear()
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	mSummary = DisplayPortAUXStatisticsSummary();
+	mSummary.mTurnaround.Init( 10000, 41, false );	// 10us buckets up to the 400us reply timeout
+	mSummary.mGaps.Init( 1000, 32, true );			// 1us, 2us, 4us, ... up to about 1 hour
+	mSummary.mRetryRuns.Init( 1, 17, false );
+	mSummary.mRetryStorms = 0;
+	mSummary.mDecoderBitRate = 0;
+	mSummary.mBitRateDetected = false;
+
+	mHaveTransactionEnd = false;
+	mTransactionEnd = 0;
+	mRequestEnd = 0;
+	mLastDeferred = false;
+	mLastCommand = 0;
+	mLastAddress = 0;
+	mLastLength = 0;
+	mRetryRun = 0;
+}
+
+void DisplayPortAUXStatistics::AddSync( U64 bit_rate )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	U64 scale = 1;
+	while( bit_rate / scale >= 1000 )
+		scale *= 10;
+
+	mSummary.mBitRate.Add( bit_rate );
+	++mSummary.mBitRates[ ( ( bit_rate + scale / 2 ) / scale ) * scale ];
+}
+
+void DisplayPortAUXStatistics::AddRequest( U64 start_ns, U64 end_ns, const DisplayPortAUXBurst& request )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	if( ( mHaveTransactionEnd == true ) && ( start_ns >= mTransactionEnd ) )
+		mSummary.mGaps.Add( start_ns - mTransactionEnd );
+	mHaveTransactionEnd = true;
+	mTransactionEnd = end_ns;
+	mRequestEnd = end_ns;
+
+	if( ( mLastDeferred == true ) && ( request.mCommand == mLastCommand ) && ( request.mAddress == mLastAddress ) && ( request.mLength == mLastLength ) )
+		++mRetryRun;
+	else
+		EndRetryRun();
+	mLastDeferred = false;
+	mLastCommand = request.mCommand;
+	mLastAddress = request.mAddress;
+	mLastLength = request.mLength;
+
+	++mSummary.mTotal.mRequests;
+	++mSummary.mAddressRanges[ GetAddressRange( request ) ].mRequests;
+}
+
+void DisplayPortAUXStatistics::AddReply( const DisplayPortAUXBurst& request, const DisplayPortAUXBurst& reply, U64 start_ns, U64 end_ns )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	if( start_ns >= mRequestEnd )
+		mSummary.mTurnaround.Add( start_ns - mRequestEnd );
+	mTransactionEnd = end_ns;
+
+	DisplayPortAUXReplyCounters& range = mSummary.mAddressRanges[ GetAddressRange( request ) ];
+	bool i2c = request.IsNative() == false;
+	if( ( reply.GetNativeReply() == AUXReplyDefer ) || ( ( i2c == true ) && ( reply.GetNativeReply() == AUXReplyAck ) && ( reply.GetI2CReply() == AUXReplyDefer ) ) )
+	{
+		++mSummary.mTotal.mDefers;
+		++range.mDefers;
+		mLastDeferred = true;
+	}
+	else if( ( reply.GetNativeReply() == AUXReplyNack ) || ( ( i2c == true ) && ( reply.GetNativeReply() == AUXReplyAck ) && ( reply.GetI2CReply() == AUXReplyNack ) ) )
+	{
+		++mSummary.mTotal.mNacks;
+		++range.mNacks;
+	}
+	else if( reply.GetNativeReply() == AUXReplyAck )
+	{
+		++mSummary.mTotal.mAcks;
+		++range.mAcks;
+	}
+}
+
+void DisplayPortAUXStatistics::AddNoReply( const DisplayPortAUXBurst& request )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	++mSummary.mTotal.mNoReplies;
+	++mSummary.mAddressRanges[ GetAddressRange( request ) ].mNoReplies;
+}
+
+void DisplayPortAUXStatistics::SetDecoderCounters( const DisplayPortAUXDecoderCounters& counters )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+	mSummary.mDecoder = counters;
+}
+
+void DisplayPortAUXStatistics::SetDecoderBitRate( U64 bit_rate, bool detected )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+	mSummary.mDecoderBitRate = bit_rate;
+	mSummary.mBitRateDetected = detected;
+}
+
+DisplayPortAUXStatisticsSummary DisplayPortAUXStatistics::GetSummary()
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	DisplayPortAUXStatisticsSummary summary = mSummary;
+	if( mRetryRun != 0 )	// the run that is still going on
+	{
+		summary.mRetryRuns.Add( mRetryRun );
+		if( mRetryRun >= StormRetries )
+			++summary.mRetryStorms;
+	}
+	return summary;
+}
+
+U32 DisplayPortAUXStatistics::GetAddressRange( const DisplayPortAUXBurst& request )
+{
+	if( request.IsNative() == true )
+		return request.mAddress & ~U32( 0xFF );
+	return ( request.mAddress & 0x7F ) | I2CRangeFlag;
+}
+
+void DisplayPortAUXStatistics::EndRetryRun()
+{
+	if( mRetryRun == 0 )
+		return;
+
+	mSummary.mRetryRuns.Add( mRetryRun );
+	if( mRetryRun >= StormRetries )
+		++mSummary.mRetryStorms;
+	mRetryRun = 0;
+}
@@ -0,0 +1,157 @@
+#ifndef DISPLAYPORTAUX_STATISTICS
+#define DISPLAYPORTAUX_STATISTICS
+
+#include "DisplayPortAUXTypes.h"
+#include <map>
+#include <mutex>
+#include <vector>
+
+struct DisplayPortAUXBurst;
+
+// Timing and reply statistics, updated by the transaction parser as bursts are decoded, so the
+// summary never needs another pass over the frames. Times are in nanoseconds.
+//  - turnaround: end of a request to the start of its reply
+//  - gap: end of a transaction (its reply, or the request if there was none) to the next request
+//  - retry run: repeats of a request after DEFER replies; StormRetries or more is a retry storm
+//  - reply counters per address range: 256 byte DPCD pages, or the I2C address
+//  - SYNC bit rates, rounded to 3 significant digits
+// The decoder also publishes its own counters here (edges, bytes, sync, error causes, time), so a
+// slow or lossy decode can be told apart from a bad signal.
+// Written by the decoder thread, read by the UI and export threads.
+
+enum DisplayPortAUXDecodeError
+{
+	AUXErrorStartFirstBit,		// START is followed by a long first data half-bit
+	AUXErrorStartSecondHalf,	// long interval after SYNC, but not a START; the decoder keeps looking
+	AUXErrorDataHalfBit,		// second half-bit of equal bits isn't short
+	AUXErrorDataInterval,		// interval within a byte is neither a half nor a full bit
+	AUXErrorStopHalfBit,		// after a byte, the second half-bit is neither short nor the STOP
+	AUXErrorStopInterval,		// after a byte, the interval is neither a data bit nor the STOP
+	AUXErrorStopIdle,			// the second half of STOP has a transition
+	AUXErrorFauxInvalidCode,	// not an 8b/10b code word
+	AUXErrorFauxUnexpectedSymbol,
+	AUXErrorFauxNoStop,			// the line went idle in a burst
+	AUXErrorCount
+};
+
+struct DisplayPortAUXDecoderCounters
+{
+	DisplayPortAUXDecoderCounters() : mEdges( 0 ), mBytes( 0 ), mBursts( 0 ), mSyncAcquired( 0 ), mSyncLost( 0 ), mGlitches( 0 ), mSkippedEdges( 0 ), mDecodeNs( 0 ), mSourceNs( 0 )
+	{
+		for( U32 i = 0; i < AUXErrorCount; ++i )
+			mErrors[ i ] = 0;
+	}
+
+	U64 mEdges;
+	U64 mBytes;
+	U64 mBursts;		// with STOP
+	U64 mSyncAcquired;	// START found
+	U64 mSyncLost;		// burst ended by an error
+	U64 mGlitches;		// pulses removed ahead of the decoder
+	U64 mSkippedEdges;	// rest of a burst after an error, up to the next idle gap
+	U64 mErrors[ AUXErrorCount ];
+	U64 mDecodeNs;		// wall clock time spent decoding...
+	U64 mSourceNs;		// ...and waiting for edges
+
+	static const char* GetErrorName( U32 error );
+};
+
+struct DisplayPortAUXRange
+{
+	DisplayPortAUXRange() : mCount( 0 ), mMin( 0 ), mMax( 0 ), mSum( 0 ) {}
+
+	void Add( U64 value );
+	U64 GetMean() const { return ( mCount != 0 ) ? mSum / mCount : 0; }
+
+	U64 mCount;
+	U64 mMin;
+	U64 mMax;
+	U64 mSum;
+};
+
+struct DisplayPortAUXHistogram
+{
+	DisplayPortAUXHistogram() : mBucketWidth( 1 ), mLogarithmic( false ) {}
+
+	// linear: bucket i is [ i * width, ( i + 1 ) * width )
+	// logarithmic: bucket 0 is [ 0, width ), bucket i is [ width << ( i - 1 ), width << i )
+	// the last bucket also counts everything above it
+	void Init( U64 bucket_width, U32 num_buckets, bool logarithmic );
+	void Add( U64 value );
+	U64 GetBucketStart( U32 bucket ) const;
+
+	std::vector< U64 > mCounts;
+	U64 mBucketWidth;
+	bool mLogarithmic;
+	DisplayPortAUXRange mRange;
+};
+
+struct DisplayPortAUXReplyCounters
+{
+	DisplayPortAUXReplyCounters() : mRequests( 0 ), mAcks( 0 ), mNacks( 0 ), mDefers( 0 ), mNoReplies( 0 ) {}
+
+	U64 mRequests;
+	U64 mAcks;
+	U64 mNacks;		// native or I2C
+	U64 mDefers;	// native or I2C
+	U64 mNoReplies;	// timed out, or the next request came first
+};
+
+struct DisplayPortAUXStatisticsSummary
+{
+	DisplayPortAUXReplyCounters mTotal;
+	std::map< U32, DisplayPortAUXReplyCounters > mAddressRanges;	// by GetAddressRange()
+	DisplayPortAUXHistogram mTurnaround;
+	DisplayPortAUXHistogram mGaps;
+	DisplayPortAUXHistogram mRetryRuns;	// only runs of at least one retry
+	U64 mRetryStorms;
+	DisplayPortAUXRange mBitRate;
+	std::map< U64, U64 > mBitRates;	// rounded bit rate, bursts
+	U64 mDecoderBitRate;	// the decoder's nominal bit rate...
+	bool mBitRateDetected;	// ...detected from the first edges, or the setting
+	DisplayPortAUXDecoderCounters mDecoder;
+};
+
+class DisplayPortAUXStatistics
+{
+public:
+	enum
+	{
+		StormRetries = 7,	// a source retries a DEFERred request at least 7 times before giving up
+		I2CRangeFlag = 1 << 24
+	};
+
+	DisplayPortAUXStatistics();
+
+	void Clear();
+
+	void AddSync( U64 bit_rate );
+	void AddRequest( U64 start_ns, U64 end_ns, const DisplayPortAUXBurst& request );
+	void AddReply( const DisplayPortAUXBurst& request, const DisplayPortAUXBurst& reply, U64 start_ns, U64 end_ns );
+	void AddNoReply( const DisplayPortAUXBurst& request );
+	void SetDecoderCounters( const DisplayPortAUXDecoderCounters& counters );
+	void SetDecoderBitRate( U64 bit_rate, bool detected );
+
+	DisplayPortAUXStatisticsSummary GetSummary();
+
+	// DPCD page start address, or I2C address | I2CRangeFlag
+	static U32 GetAddressRange( const DisplayPortAUXBurst& request );
+
+protected:
+	void EndRetryRun();
+
+	std::mutex mMutex;
+	DisplayPortAUXStatisticsSummary mSummary;
+
+	bool mHaveTransactionEnd;
+	U64 mTransactionEnd;
+	U64 mRequestEnd;
+
+	bool mLastDeferred;	// the last request got a DEFER reply
+	U8 mLastCommand;
+	U32 mLastAddress;
+	U16 mLastLength;
+	U64 mRetryRun;
+};
+
+#endif //DISPLAYPORTAUX_STATISTICS
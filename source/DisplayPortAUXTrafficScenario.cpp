@@ -0,0 +1,308 @@
+#include "DisplayPortAUXTrafficScenario.h"
+#include "DisplayPortAUXTransaction.h"
+#include "DisplayPortAUXEdid.h"
+#include <cstring>
+
+namespace
+{
+	// ns; a sink has to reply within 300us, a source waits at least 400us before it retries
+	const U32 gTurnaroundMinNs = 10000;
+	const U32 gTurnaroundMaxNs = 40000;
+	const U32 gGapMinNs = 50000;
+	const U32 gGapMaxNs = 500000;
+	const U32 gRetryMinNs = 400000;
+	const U32 gRetryMaxNs = 600000;
+	const U32 gCrPollNs = 100000;	// TRAINING_AUX_RD_INTERVAL for clock recovery
+	const U32 gEqPollNs = 400000;	// and for channel equalization
+
+	const U8 gEdidHeader[ 8 ] = { 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
+}
+
+DisplayPortAUXTrafficScenario::DisplayPortAUXTrafficScenario()
+{
+	Init( ScenarioCounter, 1000000, 8 );
+}
+
+void DisplayPortAUXTrafficScenario::Init( DisplayPortAUXScenarioType type, U32 bit_rate, U32 idle_bits )
+{
+	mType = type;
+	mCounterIdleNs = U64( idle_bits ) * 1000000000ull / ( ( bit_rate != 0 ) ? bit_rate : 1 );
+	mCounter = 1;
+	mRandom = 0x2545F491;
+	mQueue.clear();
+
+	// a sink with DPCD 1.2, 5.4 Gbps, 4 lanes and enhanced framing, powered up
+	memset( mDpcd, 0, sizeof( mDpcd ) );
+	mDpcd[ 0x000 ] = 0x12;
+	mDpcd[ 0x001 ] = 0x14;
+	mDpcd[ 0x002 ] = 0x84;
+	mDpcd[ 0x003 ] = 0x01;
+	mDpcd[ 0x004 ] = 0x01;
+	mDpcd[ 0x005 ] = 0x01;
+	mDpcd[ 0x007 ] = 0x01;
+	mDpcd[ 0x00E ] = 0x01;
+	mDpcd[ 0x200 ] = 0x01;
+	mDpcd[ 0x600 ] = 0x01;
+
+	// base block and one CTA extension, random contents with a valid header and checksums
+	for( U32 i = 0; i < U32( EdidSize ); ++i )
+		mEdid[ i ] = U8( Random( 256 ) );
+	memcpy( mEdid, gEdidHeader, sizeof( gEdidHeader ) );
+	mEdid[ 18 ] = 1;
+	mEdid[ 19 ] = 4;
+	mEdid[ 126 ] = 1;
+	mEdid[ 128 ] = 0x02;
+	mEdid[ 129 ] = 0x03;
+	for( U32 block = 0; block < U32( EdidSize ) / DisplayPortAUXEdidReassembler::BlockSize; ++block )
+	{
+		U8* data = mEdid + block * DisplayPortAUXEdidReassembler::BlockSize;
+		U8 sum = 0;
+		for( U32 i = 0; i < DisplayPortAUXEdidReassembler::BlockSize - 1; ++i )
+			sum += data[ i ];
+		data[ DisplayPortAUXEdidReassembler::BlockSize - 1 ] = U8( 0x100 - sum );
+	}
+}
+
+const DisplayPortAUXSimBurst& DisplayPortAUXTrafficScenario::NextBurst()
+{
+	if( mQueue.empty() == true )
+		QueueTransaction();
+
+	mCurrent.mBytes.swap( mQueue.front().mBytes );
+	mCurrent.mIdleNs = mQueue.front().mIdleNs;
+	mQueue.pop_front();
+	return mCurrent;
+}
+
+void DisplayPortAUXTrafficScenario::QueueTransaction()
+{
+	switch( mType )
+	{
+	case ScenarioCounter:
+		QueueCounter();
+		break;
+	case ScenarioNativeAux:
+		QueueNativeAux();
+		break;
+	case ScenarioDeferStorm:
+		QueueDeferStorm();
+		break;
+	case ScenarioEdidRead:
+		QueueEdidRead();
+		break;
+	case ScenarioLinkTraining:
+		QueueLinkTraining();
+		break;
+	case ScenarioMixed:
+	default:
+		{
+			U32 choice = Random( 16 );
+			if( choice < 8 )
+				QueueNativeAux();
+			else if( choice < 11 )
+				QueueDeferStorm();
+			else if( choice < 13 )
+				QueueEdidRead();
+			else
+				QueueLinkTraining();
+		}
+		break;
+	}
+}
+
+void DisplayPortAUXTrafficScenario::QueueCounter()
+{
+	mQueue.push_back( DisplayPortAUXSimBurst() );
+	for( U32 i = 0; i < 4; ++i )
+		mQueue.back().mBytes.push_back( mCounter++ );
+	mQueue.back().mIdleNs = mCounterIdleNs;
+}
+
+void DisplayPortAUXTrafficScenario::QueueNativeAux()
+{
+	switch( Random( 8 ) )
+	{
+	case 0:
+		QueueNativeRead( 0x000, 16 );	// receiver capabilities
+		break;
+	case 1:
+	case 2:
+		QueueNativeRead( 0x200, 2 );	// sink count, IRQ vector
+		break;
+	case 3:
+		QueueNativeRead( 0x100, 8 );	// link configuration
+		break;
+	case 4:
+		{
+			U8 power = U8( 1 + Random( 2 ) * 4 );	// D0 or D3
+			QueueNativeWrite( 0x600, &power, 1 );
+		}
+		break;
+	case 5:
+		{
+			U8 link[ 2 ] = { 0x14, 0x84 };
+			QueueNativeWrite( 0x100, link, 2 );
+		}
+		break;
+	case 6:
+		{
+			U8 data = U8( Random( 256 ) );
+			QueueNativeWrite( Random( 0x100 ), &data, 1 );	// receiver capabilities are read only
+		}
+		break;
+	default:
+		QueueNativeRead( Random( DpcdSize - 16 ), 1 + Random( 16 ) );
+		break;
+	}
+}
+
+void DisplayPortAUXTrafficScenario::QueueDeferStorm()
+{
+	U32 retries = MinDeferRetries + Random( MaxDeferRetries - MinDeferRetries + 1 );
+	bool i2c = Random( 2 ) == 0;
+	U8 offset = U8( Random( 256 ) );
+
+	for( U32 i = 0; i < retries; ++i )
+	{
+		if( i2c == true )
+			QueueRequest( AUXCmdI2CWrite, DisplayPortAUXEdidReassembler::EdidAddress, &offset, 1, false );
+		else
+			QueueRequest( AUXCmdNativeRead, 0x202, NULL, 6, false );
+		QueueReply( ( i2c == true ) ? U8( AUXReplyDefer << 2 ) : U8( AUXReplyDefer ), NULL, 0 );
+		mQueue.back().mIdleNs = gRetryMinNs + Random( gRetryMaxNs - gRetryMinNs );
+	}
+
+	if( i2c == true )
+	{
+		QueueRequest( AUXCmdI2CWrite, DisplayPortAUXEdidReassembler::EdidAddress, &offset, 1, false );
+		QueueReply( AUXReplyAck, NULL, 0 );
+	}
+	else
+	{
+		QueueNativeRead( 0x202, 6 );
+	}
+}
+
+void DisplayPortAUXTrafficScenario::QueueEdidRead()
+{
+	// E-DDC: set the word offset, read the blocks in chunks, then end the I2C transaction
+	U8 offset = 0;
+	QueueRequest( AUXCmdI2CWrite | AUXCmdI2CMOT, DisplayPortAUXEdidReassembler::EdidAddress, &offset, 1, false );
+	QueueReply( AUXReplyAck, NULL, 0 );
+
+	for( U32 i = 0; i < U32( EdidSize ); i += EdidChunk )
+	{
+		while( Random( 8 ) == 0 )	// the sink hasn't fetched the bytes from the monitor yet
+		{
+			QueueRequest( AUXCmdI2CRead | AUXCmdI2CMOT, DisplayPortAUXEdidReassembler::EdidAddress, NULL, EdidChunk, false );
+			QueueReply( U8( AUXReplyDefer << 2 ), NULL, 0 );
+		}
+		QueueRequest( AUXCmdI2CRead | AUXCmdI2CMOT, DisplayPortAUXEdidReassembler::EdidAddress, NULL, EdidChunk, false );
+		QueueReply( AUXReplyAck, mEdid + i, EdidChunk );
+	}
+
+	QueueRequest( AUXCmdI2CRead, DisplayPortAUXEdidReassembler::EdidAddress, NULL, 0, true );
+	QueueReply( AUXReplyAck, NULL, 0 );
+}
+
+void DisplayPortAUXTrafficScenario::QueueLinkTraining()
+{
+	U8 link[ 2 ] = { 0x14, 0x84 };
+	QueueNativeWrite( 0x100, link, 2 );
+
+	// clock recovery: TPS1, raising the voltage swing until the sink reports CR done on all lanes
+	U8 training[ 5 ] = { 0x21, 0x00, 0x00, 0x00, 0x00 };
+	QueueNativeWrite( 0x102, training, 5 );
+
+	U32 cr_polls = 1 + Random( 4 );
+	for( U32 i = 0; i < cr_polls; ++i )
+	{
+		bool done = i + 1 == cr_polls;
+		mDpcd[ 0x202 ] = mDpcd[ 0x203 ] = done ? 0x11 : 0x00;
+		mDpcd[ 0x204 ] = 0x80;	// link status updated
+		mDpcd[ 0x206 ] = mDpcd[ 0x207 ] = done ? 0x00 : U8( ( i + 1 ) * 0x11 );
+		mQueue.back().mIdleNs = gCrPollNs;
+		QueueNativeRead( 0x202, 6 );
+
+		if( done == false )
+		{
+			U8 swing[ 4 ];
+			memset( swing, U8( i + 1 ), sizeof( swing ) );
+			QueueNativeWrite( 0x103, swing, 4 );
+		}
+	}
+
+	// channel equalization: TPS2 until symbol lock and interlane alignment
+	training[ 0 ] = 0x22;
+	QueueNativeWrite( 0x102, training, 1 );
+
+	U32 eq_polls = 1 + Random( 3 );
+	for( U32 i = 0; i < eq_polls; ++i )
+	{
+		bool done = i + 1 == eq_polls;
+		mDpcd[ 0x202 ] = mDpcd[ 0x203 ] = done ? 0x77 : 0x33;
+		mDpcd[ 0x204 ] = done ? 0x81 : 0x80;
+		mDpcd[ 0x206 ] = mDpcd[ 0x207 ] = 0x00;
+		mQueue.back().mIdleNs = gEqPollNs;
+		QueueNativeRead( 0x202, 6 );
+	}
+
+	training[ 0 ] = 0x00;	// training done
+	QueueNativeWrite( 0x102, training, 1 );
+}
+
+void DisplayPortAUXTrafficScenario::QueueNativeRead( U32 address, U32 length )
+{
+	QueueRequest( AUXCmdNativeRead, address, NULL, length, false );
+	if( address + length > U32( DpcdSize ) )
+		QueueReply( AUXReplyNack, NULL, 0 );
+	else
+		QueueReply( AUXReplyAck, mDpcd + address, length );
+}
+
+void DisplayPortAUXTrafficScenario::QueueNativeWrite( U32 address, const U8* data, U32 length )
+{
+	QueueRequest( AUXCmdNativeWrite, address, data, length, false );
+	if( ( address < 0x100 ) || ( address + length > U32( DpcdSize ) ) )
+	{
+		QueueReply( AUXReplyNack, NULL, 0 );
+		return;
+	}
+
+	memcpy( mDpcd + address, data, length );
+	QueueReply( AUXReplyAck, NULL, 0 );
+}
+
+void DisplayPortAUXTrafficScenario::QueueRequest( U8 command, U32 address, const U8* data, U32 length, bool address_only )
+{
+	mQueue.push_back( DisplayPortAUXSimBurst() );
+	std::vector< U8 >& bytes = mQueue.back().mBytes;
+	bytes.push_back( U8( ( command << 4 ) | ( ( address >> 16 ) & 0xF ) ) );
+	bytes.push_back( U8( address >> 8 ) );
+	bytes.push_back( U8( address ) );
+	if( address_only == false )
+		bytes.push_back( U8( length - 1 ) );
+	if( data != NULL )
+		bytes.insert( bytes.end(), data, data + length );
+
+	mQueue.back().mIdleNs = gTurnaroundMinNs + Random( gTurnaroundMaxNs - gTurnaroundMinNs );
+}
+
+void DisplayPortAUXTrafficScenario::QueueReply( U8 reply, const U8* data, U32 length )
+{
+	mQueue.push_back( DisplayPortAUXSimBurst() );
+	std::vector< U8 >& bytes = mQueue.back().mBytes;
+	bytes.push_back( U8( reply << 4 ) );
+	if( data != NULL )
+		bytes.insert( bytes.end(), data, data + length );
+
+	mQueue.back().mIdleNs = gGapMinNs + Random( gGapMaxNs - gGapMinNs );
+}
+
+U32 DisplayPortAUXTrafficScenario::Random( U32 range )
+{
+	mRandom ^= mRandom << 13;
+	mRandom ^= mRandom >> 17;
+	mRandom ^= mRandom << 5;
+	return mRandom % range;
+}
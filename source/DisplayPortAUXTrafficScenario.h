@@ -0,0 +1,82 @@
+#ifndef DISPLAYPORTAUX_TRAFFIC_SCENARIO
+#define DISPLAYPORTAUX_TRAFFIC_SCENARIO
+
+#include "DisplayPortAUXTypes.h"
+#include <deque>
+#include <vector>
+
+// Bursts for the simulation, as a source and a sink would put them on the line. A scenario queues
+// whole transactions (request, reply, retries) with the idle time after every burst; the line
+// encoder turns them into edges. Everything is derived from a fixed seed, so a simulation is the
+// same every time it runs.
+//   Counter:        bursts of 4 counting bytes without any meaning, the classic test pattern
+//   Native AUX:     DPCD reads and writes, the replies read back what was written
+//   DEFER storms:   a request answered with DEFER several times before the sink ACKs it
+//   EDID reads:     an E-DDC read of the base block and one extension block over I2C-over-AUX
+//   Link training:  clock recovery and channel equalization, polling the lane status
+//   Mixed:          all of the above at random
+
+enum DisplayPortAUXScenarioType
+{
+	ScenarioCounter,
+	ScenarioMixed,
+	ScenarioNativeAux,
+	ScenarioDeferStorm,
+	ScenarioEdidRead,
+	ScenarioLinkTraining
+};
+
+struct DisplayPortAUXSimBurst
+{
+	std::vector< U8 > mBytes;
+	U64 mIdleNs;	// line idle after the STOP
+};
+
+class DisplayPortAUXTrafficScenario
+{
+public:
+	DisplayPortAUXTrafficScenario();
+
+	// idle_bits: idle time after a counter burst, in bit periods
+	void Init( DisplayPortAUXScenarioType type, U32 bit_rate, U32 idle_bits );
+
+	const DisplayPortAUXSimBurst& NextBurst();	// valid until the next call
+
+protected:
+	enum
+	{
+		DpcdSize = 0x800,
+		EdidSize = 256,
+		EdidChunk = 16,			// bytes per I2C-over-AUX read
+		MinDeferRetries = 4,
+		MaxDeferRetries = 12
+	};
+
+	void QueueTransaction();
+	void QueueCounter();
+	void QueueNativeAux();
+	void QueueDeferStorm();
+	void QueueEdidRead();
+	void QueueLinkTraining();
+
+	// a request is followed by the sink's turnaround time, a reply by the gap to the next transaction
+	void QueueNativeRead( U32 address, U32 length );
+	void QueueNativeWrite( U32 address, const U8* data, U32 length );
+	void QueueRequest( U8 command, U32 address, const U8* data, U32 length, bool address_only );
+	void QueueReply( U8 reply, const U8* data, U32 length );
+
+	U32 Random( U32 range );	// 0 .. range - 1
+
+	DisplayPortAUXScenarioType mType;
+	U64 mCounterIdleNs;
+	U8 mCounter;
+	U32 mRandom;	// xorshift state
+
+	U8 mDpcd[ DpcdSize ];
+	U8 mEdid[ EdidSize ];
+
+	std::deque< DisplayPortAUXSimBurst > mQueue;
+	DisplayPortAUXSimBurst mCurrent;
+};
+
+#endif //DISPLAYPORTAUX_TRAFFIC_SCENARIO
@@ -0,0 +1,242 @@
+#include "DisplayPortAUXTransaction.h"
+
+static const char* gCommandNames[] =	// indexed by the request command nibble
+{
+	"I2C Write", "I2C Read", "I2C Write Status", "Reserved",
+	"I2C Write MOT", "I2C Read MOT", "I2C Write Status MOT", "Reserved",
+	"Native Write", "Native Read", "Reserved", "Reserved",
+	"Reserved", "Reserved", "Reserved", "Reserved"
+};
+
+static const char* gNativeReplyNames[] = { "ACK", "NACK", "DEFER", "Reserved" };
+static const char* gI2CReplyNames[] = { "ACK", "I2C NACK", "I2C DEFER", "I2C Reserved" };
+
+void DisplayPortAUXBurst::Unpack( U64 data1, U64 data2 )
+{
+	mAddress = U32( data1 & 0xFFFFF );
+	mLength = U16( data1 >> 32 );
+	mEdidStatus = U8( data1 >> 48 );
+	mEdidBlock = U8( data1 >> 56 );
+	mKind = DisplayPortAUXBurstKind( data2 & 0xFF );
+	mCommand = U8( data2 >> 8 );
+	mDataCount = U8( data2 >> 16 );
+	mTransaction = U32( data2 >> 32 );
+}
+
+const char* DisplayPortAUXBurst::GetCommandName() const
+{
+	return gCommandNames[ mCommand & 0xF ];
+}
+
+const char* DisplayPortAUXBurst::GetReplyName() const
+{
+	if( GetNativeReply() != AUXReplyAck )
+		return gNativeReplyNames[ GetNativeReply() ];
+	return gI2CReplyNames[ GetI2CReply() ];
+}
+
+DisplayPortAUXTransactionParser::DisplayPortAUXTransactionParser()
+{
+	Init( 0, NULL, NULL, NULL );
+}
+
+void DisplayPortAUXTransactionParser::Init( U32 sample_rate_hz, DisplayPortAUXDpcdShadow* dpcd, DisplayPortAUXEdidReassembler* edid, DisplayPortAUXStatistics* statistics )
+{
+	mSampleRateHz = sample_rate_hz;
+	mReplyTimeout = U64( sample_rate_hz ) / 2500;	// 400us, the longest a source waits for a reply
+	mDpcd = dpcd;
+	mEdid = edid;
+	mStatistics = statistics;
+	mBurstOpen = false;
+	mBurstFinished = false;
+	mBurstStart = 0;
+	mBurstEnd = 0;
+	mByteCount = 0;
+	mRequestPending = false;
+	mRequestEnd = 0;
+	mTransactionNum = 0;
+}
+
+void DisplayPortAUXTransactionParser::AddFrame( DisplayPortAUXFrame& frame )
+{
+	switch( frame.mType )
+	{
+	case AUXSync:
+		mBurstOpen = true;
+		mBurstFinished = false;
+		mBurstStart = frame.mStartingSampleInclusive;
+		mByteCount = 0;
+		if( mStatistics != NULL )
+			mStatistics->AddSync( frame.mData2 );
+		break;
+	case AUXData:
+		if( mByteCount < MaxBurstBytes )
+			mBytes[ mByteCount ] = U8( frame.mData1 );
+		++mByteCount;
+		break;
+	case AUXStop:
+		mBurstEnd = frame.mEndingSampleInclusive;
+		FinishBurst( true );
+		frame.mData1 = mBurst.PackData1();
+		frame.mData2 = mBurst.PackData2();
+		frame.mFlags = ( mBurst.mEdidStatus == AUXEdidChecksumError ) ? AUXFlagError : 0;
+		break;
+	}
+}
+
+U32 DisplayPortAUXTransactionParser::EndBurst()
+{
+	if( mBurstFinished == false )
+		FinishBurst( false );
+
+	mBurstOpen = false;
+	return mBurst.mTransaction;
+}
+
+void DisplayPortAUXTransactionParser::FinishBurst( bool complete )
+{
+	mBurstFinished = true;
+	mBurst.mKind = AUXBurstIncomplete;
+	mBurst.mCommand = 0;
+	mBurst.mAddress = 0;
+	mBurst.mLength = 0;
+	mBurst.mDataCount = 0;
+	mBurst.mTransaction = 0;
+	mBurst.mEdidStatus = AUXEdidNone;
+	mBurst.mEdidBlock = 0;
+
+	if( complete == false )
+		return;	// the request stays pending, its reply may still follow
+
+	if( ( mRequestPending == true ) && ( mBurstStart - mRequestEnd > mReplyTimeout ) )
+	{
+		mRequestPending = false;	// reply timed out, this burst is the next request
+		if( mStatistics != NULL )
+			mStatistics->AddNoReply( mRequest );
+	}
+
+	if( mRequestPending == true )
+		ParseReply();
+	else
+		ParseRequest();
+}
+
+void DisplayPortAUXTransactionParser::ParseRequest()
+{
+	if( mByteCount < 3 )
+	{
+		mBurst.mKind = AUXBurstInvalid;
+		return;
+	}
+
+	U8 command = mBytes[ 0 ] >> 4;
+	bool native = ( command & AUXCmdNativeWrite ) != 0;
+	if( ( native == true ) ? ( command > AUXCmdNativeRead ) || ( mByteCount < 4 ) : ( command & 0x3 ) == 0x3 )
+	{
+		mBurst.mKind = AUXBurstInvalid;
+		return;
+	}
+
+	mBurst.mKind = AUXBurstRequest;
+	mBurst.mCommand = command;
+	mBurst.mAddress = ( U32( mBytes[ 0 ] & 0xF ) << 16 ) | ( U32( mBytes[ 1 ] ) << 8 ) | mBytes[ 2 ];
+	if( mByteCount >= 4 )
+	{
+		mBurst.mLength = U16( mBytes[ 3 ] ) + 1;
+		mBurst.mDataCount = U8( ( mByteCount - 4 < 0xFF ) ? mByteCount - 4 : 0xFF );
+	}
+	mBurst.mTransaction = ++mTransactionNum;
+
+	mRequestPending = true;
+	mRequestEnd = mBurstEnd;
+	mRequest = mBurst;
+	for( U32 i = 0; ( i < mBurst.mDataCount ) && ( 4 + i < MaxBurstBytes ); ++i )
+		mRequestData[ i ] = mBytes[ 4 + i ];
+
+	if( mStatistics != NULL )
+		mStatistics->AddRequest( SamplesToNs( mBurstStart ), SamplesToNs( mBurstEnd ), mBurst );
+}
+
+void DisplayPortAUXTransactionParser::ParseReply()
+{
+	mRequestPending = false;
+
+	if( ( mByteCount == 0 ) || ( ( mBytes[ 0 ] & 0xF ) != 0 ) )	// the padding of a reply is always 0
+	{
+		if( mStatistics != NULL )
+			mStatistics->AddNoReply( mRequest );
+		ParseRequest();	// the reply got lost, this is already the next request
+		return;
+	}
+
+	mBurst.mKind = AUXBurstReply;
+	mBurst.mCommand = mBytes[ 0 ] >> 4;
+	mBurst.mDataCount = U8( ( mByteCount - 1 < 0xFF ) ? mByteCount - 1 : 0xFF );
+	mBurst.mTransaction = mTransactionNum;
+
+	if( mStatistics != NULL )
+		mStatistics->AddReply( mRequest, mBurst, SamplesToNs( mBurstStart ), SamplesToNs( mBurstEnd ) );
+
+	if( mBurst.GetNativeReply() != AUXReplyAck )
+		return;
+
+	if( mRequest.IsNative() == true )
+	{
+		if( mDpcd != NULL )
+			UpdateDpcd();
+	}
+	else if( ( mEdid != NULL ) && ( mBurst.GetI2CReply() == AUXReplyAck ) )
+	{
+		UpdateEdid();
+	}
+}
+
+void DisplayPortAUXTransactionParser::UpdateDpcd()
+{
+	U32 count;
+	if( mRequest.mCommand == AUXCmdNativeWrite )
+	{
+		count = ( mRequest.mDataCount < mRequest.mLength ) ? mRequest.mDataCount : mRequest.mLength;
+		if( count > MaxBurstBytes - 4 )
+			count = MaxBurstBytes - 4;
+		mDpcd->Write( mBurstEnd, mRequest.mAddress, mRequestData, count );
+	}
+	else
+	{
+		count = ( mBurst.mDataCount < mRequest.mLength ) ? mBurst.mDataCount : mRequest.mLength;	// a short read is still valid
+		if( count > MaxBurstBytes - 1 )
+			count = MaxBurstBytes - 1;
+		mDpcd->Write( mBurstEnd, mRequest.mAddress, mBytes + 1, count );
+	}
+}
+
+void DisplayPortAUXTransactionParser::UpdateEdid()
+{
+	bool read = ( mRequest.mCommand & 0x3 ) == AUXCmdI2CRead;
+	bool stop = ( mRequest.mCommand & AUXCmdI2CMOT ) == 0;
+	const U8* data;
+	U32 count;
+	if( read == true )
+	{
+		data = mBytes + 1;
+		count = ( mBurst.mDataCount < MaxBurstBytes - 1 ) ? mBurst.mDataCount : MaxBurstBytes - 1;
+	}
+	else
+	{
+		data = mRequestData;
+		count = ( mRequest.mCommand & 0x3 ) == AUXCmdI2CWrite ? mRequest.mDataCount : 0;	// a status update request carries no data
+		if( count > MaxBurstBytes - 4 )
+			count = MaxBurstBytes - 4;
+	}
+
+	U32 block_index = 0;
+	mBurst.mEdidStatus = U8( mEdid->AddTransfer( mBurstEnd, mRequest.mAddress, read, stop, data, count, block_index ) );
+	mBurst.mEdidBlock = U8( block_index );
+}
+
+U64 DisplayPortAUXTransactionParser::SamplesToNs( U64 samples ) const
+{
+	if( mSampleRateHz == 0 )
+		return 0;
+	return ( samples / mSampleRateHz ) * 1000000000ULL + ( ( samples % mSampleRateHz ) * 1000000000ULL ) / mSampleRateHz;
+}
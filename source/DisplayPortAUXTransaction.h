@@ -0,0 +1,111 @@
+#ifndef DISPLAYPORTAUX_TRANSACTION
+#define DISPLAYPORTAUX_TRANSACTION
+
+#include "DisplayPortAUXTypes.h"
+#include "DisplayPortAUXDpcd.h"
+#include "DisplayPortAUXEdid.h"
+#include "DisplayPortAUXStatistics.h"
+
+// AUX request/reply layer. Every burst (SYNC, START, bytes, STOP) is either a request from the source:
+//   byte 0 = command << 4 | address[19:16], byte 1 = address[15:8], byte 2 = address[7:0],
+//   byte 3 = length - 1 (missing for address only I2C requests), then the write data
+// or a reply from the sink:
+//   byte 0 = reply << 4 (bits 1:0 native, bits 3:2 I2C), then the read data.
+// The parser follows the frames as they are decoded, so requests are matched to their replies
+// without another pass over the results. The summary of a burst is stored in its STOP frame.
+// Acknowledged native writes and read replies update the DPCD shadow, acknowledged I2C transfers
+// go to the EDID reassembler, and every request and reply is counted in the statistics (any of them
+// may be missing).
+
+enum DisplayPortAUXRequestCommand
+{
+	AUXCmdI2CWrite = 0x0,
+	AUXCmdI2CRead = 0x1,
+	AUXCmdI2CWriteStatusUpdate = 0x2,
+	AUXCmdI2CMOT = 0x4,	// middle of transaction, I2C commands only
+	AUXCmdNativeWrite = 0x8,
+	AUXCmdNativeRead = 0x9
+};
+
+enum DisplayPortAUXReplyCode
+{
+	AUXReplyAck = 0x0,
+	AUXReplyNack = 0x1,
+	AUXReplyDefer = 0x2
+};
+
+enum DisplayPortAUXBurstKind
+{
+	AUXBurstIncomplete,	// no STOP, the bytes can't be trusted
+	AUXBurstRequest,
+	AUXBurstReply,
+	AUXBurstInvalid		// complete, but neither a request nor a reply
+};
+
+struct DisplayPortAUXBurst
+{
+	DisplayPortAUXBurstKind mKind;
+	U8 mCommand;		// request command or reply code nibble
+	U32 mAddress;		// requests only
+	U16 mLength;		// requests only, bytes to read/write (0 = address only)
+	U8 mDataCount;		// bytes after the header
+	U32 mTransaction;	// 0 = not part of a transaction
+	U8 mEdidStatus;		// replies only, DisplayPortAUXEdidStatus of the block this reply completed
+	U8 mEdidBlock;
+
+	// STOP frame mData1/mData2 layout
+	U64 PackData1() const { return U64( mAddress ) | ( U64( mLength ) << 32 ) | ( U64( mEdidStatus ) << 48 ) | ( U64( mEdidBlock ) << 56 ); }
+	U64 PackData2() const { return U64( mKind ) | ( U64( mCommand ) << 8 ) | ( U64( mDataCount ) << 16 ) | ( U64( mTransaction ) << 32 ); }
+	void Unpack( U64 data1, U64 data2 );
+
+	bool IsNative() const { return ( mCommand & AUXCmdNativeWrite ) != 0; }	// requests only
+	U8 GetNativeReply() const { return mCommand & 0x3; }	// replies only
+	U8 GetI2CReply() const { return ( mCommand >> 2 ) & 0x3; }
+
+	const char* GetCommandName() const;
+	const char* GetReplyName() const;
+};
+
+class DisplayPortAUXTransactionParser
+{
+public:
+	DisplayPortAUXTransactionParser();
+
+	void Init( U32 sample_rate_hz, DisplayPortAUXDpcdShadow* dpcd, DisplayPortAUXEdidReassembler* edid, DisplayPortAUXStatistics* statistics );
+
+	void AddFrame( DisplayPortAUXFrame& frame );	// stores the burst summary in the STOP frame
+	bool IsBurstOpen() const { return mBurstOpen; }
+	U32 EndBurst();	// transaction of the burst that just ended, 0 if none
+
+protected:
+	enum { MaxBurstBytes = 20 };	// 4 header + 16 data
+
+	void FinishBurst( bool complete );
+	void ParseRequest();
+	void ParseReply();
+	void UpdateDpcd();
+	void UpdateEdid();
+	U64 SamplesToNs( U64 samples ) const;
+
+	U32 mSampleRateHz;
+	U64 mReplyTimeout;	// samples from the end of a request to the START of its reply
+	DisplayPortAUXDpcdShadow* mDpcd;
+	DisplayPortAUXEdidReassembler* mEdid;
+	DisplayPortAUXStatistics* mStatistics;
+
+	bool mBurstOpen;
+	bool mBurstFinished;
+	U64 mBurstStart;
+	U64 mBurstEnd;
+	U8 mBytes[ MaxBurstBytes ];
+	U32 mByteCount;
+	DisplayPortAUXBurst mBurst;
+
+	bool mRequestPending;	// a request is waiting for its reply
+	U64 mRequestEnd;
+	DisplayPortAUXBurst mRequest;
+	U8 mRequestData[ MaxBurstBytes ];	// write data of mRequest
+	U32 mTransactionNum;
+};
+
+#endif //DISPLAYPORTAUX_TRANSACTION
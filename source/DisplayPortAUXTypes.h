@@ -0,0 +1,43 @@
+#ifndef DISPLAYPORTAUX_TYPES
+#define DISPLAYPORTAUX_TYPES
+
+// Basic types shared by the SDK independent parts of the analyzer (decoder, protocol layers).
+// The typedefs are identical to the ones in AnalyzerTypes.h, so both headers can be included together.
+
+typedef signed long long int S64;
+typedef unsigned long long int U64;
+typedef signed int S32;
+typedef unsigned int U32;
+typedef unsigned short int U16;
+typedef unsigned char U8;
+
+enum DisplayPortAUXFrameType { AUXSync, AUXStart, AUXData, AUXStop, AUXDataBlock };
+enum DisplayPortAUXFrameFlags { AUXFlagByteCountMask = 0x1F, AUXFlagWarning = 1 << 6, AUXFlagError = 1 << 7 };	// same bits as DISPLAY_AS_WARNING_FLAG/DISPLAY_AS_ERROR_FLAG
+enum DisplayPortAUXMarkerDensity { MarkersAllBits, MarkersStartStopErrors, MarkersNone };
+
+// same fields as the SDK Frame
+struct DisplayPortAUXFrame
+{
+	S64 mStartingSampleInclusive;
+	S64 mEndingSampleInclusive;
+	U64 mData1;
+	U64 mData2;
+	U8 mType;
+	U8 mFlags;
+};
+
+// An AUXDataBlock frame carries up to 16 consecutive data bytes of one burst instead of one AUXData
+// frame per byte: byte i in bits 8 * ( i % 8 ) of mData1 (bytes 0-7) or mData2 (bytes 8-15), the
+// number of bytes in the low bits of mFlags. The frame spans all of its bytes; the bytes are
+// assumed to be equally long when a time per byte is needed.
+struct DisplayPortAUXDataBlock
+{
+	enum { MaxBytes = 16 };
+
+	static U32 GetCount( U8 flags ) { return flags & AUXFlagByteCountMask; }
+	static U8 GetByte( U64 data1, U64 data2, U32 index ) { return U8( ( ( index < 8 ) ? data1 : data2 ) >> ( 8 * ( index % 8 ) ) ); }
+	static void SetByte( U64& data1, U64& data2, U32 index, U8 value ) { ( ( index < 8 ) ? data1 : data2 ) |= U64( value ) << ( 8 * ( index % 8 ) ); }
+	static S64 GetByteStart( S64 start, S64 end, U32 count, U32 index ) { return start + ( end - start + 1 ) * S64( index ) / S64( count ); }
+};
+
+#endif //DISPLAYPORTAUX_TYPES